@@ -19,6 +19,10 @@
 ///
 /// Decimal value type. Use for capital calculations.
 /// Note: maximum handled value is: +9,223,372,036,854,775,807 (divided by prec)
+/// for default int64 storage. Storage type is the last template parameter,
+/// decimal32<Prec> (int32 storage) handles up to 9 digits and
+/// decimal128<Prec> (int128 storage, if supported by compiler) handles
+/// up to 38 digits.
 ///
 /// Sample usage:
 ///   using namespace dec;
@@ -35,14 +39,22 @@
 // - define DEC_CROSS_DOUBLE if you want to use double (instead of xdouble) for cross-conversions
 // - define DEC_EXTERNAL_LIMITS to define by yourself DEC_MAX_INT32
 // - define DEC_NO_CPP11 if your compiler does not support C++11
+// - define DEC_NO_INT128 if you do not want to use 128-bit integer intermediates
+//   (used automatically when compiler provides __int128)
 // - define DEC_TYPE_LEVEL as 0 for strong typing (same precision required for both arguments),
 //   as 1 for allowing to mix lower or equal precision types
 //   as 2 for automatic rounding when different precision is mixed
+// - define DEC_EXACT_MULT if product of different precision types decimal<P1> * decimal<P2>
+//   should be exact decimal<P1 + P2> (see exact_mult), rounded later e.g. with decimal_cast
 
 #include <iosfwd>
 #include <iomanip>
 #include <sstream>
 #include <locale>
+#include <stdexcept>
+#include <system_error>
+#include <cstring>
+#include <cmath>
 
 #ifndef DEC_TYPE_LEVEL
 #define DEC_TYPE_LEVEL 2
@@ -53,6 +65,7 @@
 #ifndef DEC_NO_CPP11
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #else
 
@@ -87,6 +100,69 @@
 #endif // DEC_NO_CPP11
 #endif // DEC_EXTERNAL_LIMITS
 
+// --> define DEC_CONSTEXPR (C++11) and DEC_CONSTEXPR14 (relaxed constexpr)
+
+#ifndef DEC_NO_CPP11
+#define DEC_CONSTEXPR constexpr
+#else
+#define DEC_CONSTEXPR
+#endif
+
+#if !defined(DEC_NO_CPP11) && defined(__cpp_constexpr) && (__cpp_constexpr >= 201304)
+#define DEC_HAS_CONSTEXPR14
+#define DEC_CONSTEXPR14 constexpr
+#else
+#define DEC_CONSTEXPR14
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define DEC_HAS_CONSTANT_EVALUATED
+#endif
+#elif defined(__GNUC__) && (__GNUC__ >= 9)
+#define DEC_HAS_CONSTANT_EVALUATED
+#endif
+
+#if defined(DEC_HAS_CONSTANT_EVALUATED) && defined(DEC_HAS_CONSTEXPR14)
+#define DEC_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define DEC_IS_CONSTANT_EVALUATED() false
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_add_overflow) && __has_builtin(__builtin_mul_overflow)
+#define DEC_HAS_BUILTIN_OVERFLOW
+#endif
+#elif defined(__GNUC__) && (__GNUC__ >= 5)
+#define DEC_HAS_BUILTIN_OVERFLOW
+#endif
+
+#ifndef DEC_NO_CPP11
+#define DEC_THREAD_LOCAL thread_local
+#else
+#define DEC_THREAD_LOCAL
+#endif
+
+// <--
+
+// --> detect byte order for SWAR digit parsing
+
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) \
+    || defined(_M_X64) || defined(_M_IX86)
+#define DEC_LITTLE_ENDIAN
+#endif
+
+// platform-specific code which cannot be evaluated at compile time
+// is used only if it can be skipped in constant expressions
+#if defined(DEC_HAS_CONSTANT_EVALUATED) || !defined(DEC_HAS_CONSTEXPR14)
+#ifdef DEC_LITTLE_ENDIAN
+#define DEC_USE_SWAR
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DEC_USE_DIVQ
+#endif
+#endif
+
 // <--
 
 namespace DEC_NAMESPACE {
@@ -114,9 +190,20 @@ typedef signed long long DEC_INT64;
 #endif
 
 typedef DEC_INT64 int64;
+typedef uint64_t uint64;
+typedef int32_t int32;
+typedef uint32_t uint32;
 // type for storing currency value internally
 typedef int64 dec_storage_t;
 typedef unsigned int uint;
+
+// --> define int128 & uint128 if compiler supports them
+#if defined(__SIZEOF_INT128__) && !defined(DEC_NO_INT128)
+#define DEC_HAS_INT128
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#endif
+// <--
 // xdouble is an "extended double" - can be long double, __float128, _Quad - as you wish
 typedef long double xdouble;
 
@@ -134,7 +221,9 @@ typedef xdouble cross_float;
 // Constants
 // ----------------------------------------------------------------------------
 enum {
-    max_decimal_points = 18
+    max_decimal_points = 18,
+    // sign + digits of int64 + decimal point + decimal points
+    max_decimal_chars = 1 + 19 + 1 + max_decimal_points
 };
 
 // ----------------------------------------------------------------------------
@@ -164,6 +253,12 @@ template<int Prec> struct DecimalFactorDiff {
     static const int64 value = DecimalFactorDiff_impl<Prec, Prec >= 0>::value;
 };
 
+// absolute value of integer
+template<class T>
+inline DEC_CONSTEXPR T int_abs(T value) {
+    return (value < 0) ? -value : value;
+}
+
 #ifndef DEC_EXTERNAL_ROUND
 
 // round floating point value and convert to int64
@@ -182,8 +277,8 @@ inline int64 round(T value) {
 }
 
 // calculate output = round(a / b), where output, a, b are int64
-inline bool div_rounded(int64 &output, int64 a, int64 b) {
-    int64 divisorCorr = std::abs(b) / 2;
+inline DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+    int64 divisorCorr = int_abs(b) / 2;
     if (a >= 0) {
         if (DEC_MAX_INT64 - a >= divisorCorr) {
             output = (a + divisorCorr) / b;
@@ -202,65 +297,384 @@ inline bool div_rounded(int64 &output, int64 a, int64 b) {
 
 #endif // DEC_EXTERNAL_ROUND
 
+#ifdef DEC_HAS_INT128
+/// Divides 128-bit values by the same 64-bit divisor using multiplication by
+/// precomputed reciprocal instead of hardware division, see:
+/// N. Moller, T. Granlund, "Improved division by invariant integers", 2011.
+class invariant_divider {
+public:
+    explicit invariant_divider(uint64 divisor) :
+            m_divisor(divisor), m_shift(__builtin_clzll(divisor)) {
+        m_normDivisor = divisor << m_shift;
+        // reciprocal = floor((2^128 - 1) / normDivisor) - 2^64
+        m_reciprocal = static_cast<uint64>(
+                ((static_cast<uint128>(~m_normDivisor) << 64) | ~static_cast<uint64>(0))
+                        / m_normDivisor);
+    }
+
+    uint64 divisor() const {
+        return m_divisor;
+    }
+
+    /// Returns quotient of (hi * 2^64 + lo) / divisor, requires hi < divisor
+    uint64 divide(uint64 hi, uint64 lo, uint64 &remainder) const {
+        if (m_shift != 0) {
+            hi = (hi << m_shift) | (lo >> (64 - m_shift));
+            lo <<= m_shift;
+        }
+
+        const uint128 estimate = static_cast<uint128>(m_reciprocal) * hi
+                + ((static_cast<uint128>(hi) << 64) | lo);
+        uint64 quotient = static_cast<uint64>(estimate >> 64) + 1;
+        uint64 rest = lo - quotient * m_normDivisor;
+
+        if (rest > static_cast<uint64>(estimate)) {
+            --quotient;
+            rest += m_normDivisor;
+        }
+        if (rest >= m_normDivisor) {
+            ++quotient;
+            rest -= m_normDivisor;
+        }
+
+        remainder = rest >> m_shift;
+        return quotient;
+    }
+
+private:
+    uint64 m_divisor;
+    int m_shift;
+    uint64 m_normDivisor;
+    uint64 m_reciprocal;
+};
+#endif // DEC_HAS_INT128
+
 template<class RoundPolicy>
 class dec_utils {
 public:
-    // result = (value1 * value2) / divisor
-    inline static int64 multDiv(const int64 value1, const int64 value2,
+    // result = (value1 * value2) / divisor, low 64 bits of truncated quotient
+    // if result does not fit in int64 (see multDivWrapped)
+    DEC_CONSTEXPR14 static int64 multDiv(const int64 value1, const int64 value2,
             int64 divisor) {
-        // we don't check for division by zero, the caller should - the next line will throw.
-        const int64 value1int = value1 / divisor;
-        int64 value1dec = value1 % divisor;
-        const int64 value2int = value2 / divisor;
-        int64 value2dec = value2 % divisor;
+        int64 fastResult = 0;
+        if (multDiv128(value1, value2, divisor, fastResult)) {
+            return fastResult;
+        }
+        // result does not fit in int64
+        return multDivWrapped(value1, value2, divisor);
+    }
+
+    // low 64 bits of truncated quotient (value1 * value2) / divisor with sign applied,
+    // used when result does not fit in int64. Only unsigned arithmetic is used,
+    // so value is defined (but meaningless) on overflow.
+    // We don't check for division by zero, the caller should - the next line will throw.
+    static DEC_CONSTEXPR14 int64 multDivWrapped(const int64 value1, const int64 value2,
+            const int64 divisor) {
+        const uint64 absDivisor = uabs(divisor);
+        uint64 productHi = 0;
+        const uint64 productLo = umul128(uabs(value1), uabs(value2), productHi);
+        uint64 remainder = productHi % absDivisor;
+        const uint64 quotient = udiv128(remainder, productLo, absDivisor, remainder);
+        const bool negative = ((value1 < 0) != (value2 < 0)) != (divisor < 0);
+        return static_cast<int64>(negative ? 0 - quotient : quotient);
+    }
+
+    // result = (value1 * value2) / divisor, calculated with 128-bit intermediate value
+    // and a single rounded division. Returns false if result does not fit in int64.
+    static DEC_CONSTEXPR14 bool multDiv128(const int64 value1, const int64 value2,
+            const int64 divisor, int64 &result) {
+        uint64 productHi = 0;
+        const uint64 productLo = umul128(uabs(value1), uabs(value2), productHi);
+        const uint64 absDivisor = uabs(divisor);
+
+        if (productHi >= absDivisor) {
+            // quotient does not fit in 64 bits (or division by zero)
+            return false;
+        }
 
-        int64 result = value1 * value2int + value1int * value2dec;
+        uint64 remainder = 0;
+        const uint64 quotient = udiv128(productHi, productLo, absDivisor, remainder);
+        const bool negative = ((value1 < 0) != (value2 < 0)) != (divisor < 0);
 
-        if (value1dec == 0 || value2dec == 0) {
-            return result;
+        return roundQuotient(negative, quotient, remainder, absDivisor, result);
+    }
+
+    // output = a / b rounded using RoundPolicy (by sign of quotient),
+    // false if result does not fit in int64
+    static DEC_CONSTEXPR14 bool divRounded(int64 &output, const int64 a, const int64 b) {
+        const uint64 absValue = uabs(a);
+        const uint64 absDivisor = uabs(b);
+        if (!roundQuotient((a < 0) != (b < 0), absValue / absDivisor, absValue % absDivisor,
+                absDivisor, output)) {
+            output = 0;
+            return false;
         }
+        return true;
+    }
 
-        if (!isMultOverflow(value1dec, value2dec)) { // no overflow
-            int64 resDecPart = value1dec * value2dec;
-            if (!RoundPolicy::div_rounded(resDecPart, resDecPart, divisor))
-                resDecPart = 0;
-            result += resDecPart;
-            return result;
+#ifdef DEC_HAS_INT128
+
+    // result = (value1 * value2) / divisor, where divisor has precomputed reciprocal.
+    // Returns false if result does not fit in int64.
+    static bool multDiv128(const int64 value1, const int64 value2,
+            const invariant_divider &divider, bool negativeDivisor, int64 &result) {
+        const uint128 product = static_cast<uint128>(uabs(value1)) * uabs(value2);
+        const uint64 productHi = static_cast<uint64>(product >> 64);
+
+        if (productHi >= divider.divisor()) {
+            return false;
         }
 
-        // minimalize value1 & divisor
-        {
-            int64 c = gcd(value1dec, divisor);
-            if (c != 1) {
-                value1dec /= c;
-                divisor /= c;
+        uint64 remainder = 0;
+        const uint64 quotient = divider.divide(productHi, static_cast<uint64>(product),
+                remainder);
+        const bool negative = ((value1 < 0) != (value2 < 0)) != negativeDivisor;
+
+        return roundQuotient(negative, quotient, remainder, divider.divisor(), result);
+    }
+
+#endif // DEC_HAS_INT128
+
+    // result = +/- (quotient rounded using remainder), false if result does not fit in int64
+    static DEC_CONSTEXPR14 bool roundQuotient(bool negative, uint64 quotient,
+            uint64 remainder, uint64 divisor, int64 &result) {
+        const uint64 limit = static_cast<uint64>(DEC_MAX_INT64) + (negative ? 1 : 0);
+
+        if (RoundPolicy::away_from_zero(negative, quotient, remainder, divisor)) {
+            if (quotient >= limit) {
+                return false;
             }
+            ++quotient;
+        } else if (quotient > limit) {
+            return false;
+        }
+
+        result = static_cast<int64>(negative ? 0 - quotient : quotient);
+        return true;
+    }
+
+    // output = a / 10^N rounded using RoundPolicy, result always fits in int64.
+    // Divisor is known at compile time, so division is done with multiplication
+    // and sign & rounding correction are applied without branches.
+    template<int N>
+    static DEC_CONSTEXPR14 bool div_rounded_pow10(int64 &output, const int64 a) {
+        static_assert((N >= 0) && (N <= max_decimal_points), "Power of 10 out of range");
+        const uint64 divisor = static_cast<uint64>(DecimalFactor<N>::value);
+        // all bits set for negative value
+        const uint64 signMask = 0 - static_cast<uint64>(a < 0);
+        const uint64 absValue = (static_cast<uint64>(a) ^ signMask) - signMask;
+        const uint64 quotient = absValue / divisor;
+        const uint64 remainder = absValue - quotient * divisor;
+        const uint64 rounded = quotient + static_cast<uint64>(
+                RoundPolicy::away_from_zero(a < 0, quotient, remainder, divisor));
+        output = static_cast<int64>((rounded ^ signMask) - signMask);
+        return true;
+    }
+
+    // Returns low 64 bits of a * b, high 64 bits are stored in hi
+    static DEC_CONSTEXPR14 uint64 umul128(uint64 a, uint64 b, uint64 &hi) {
+#ifdef DEC_HAS_INT128
+        const uint128 product = static_cast<uint128>(a) * b;
+        hi = static_cast<uint64>(product >> 64);
+        return static_cast<uint64>(product);
+#else
+        const uint64 mask = 0xffffffffu;
+        const uint64 low = (a & mask) * (b & mask);
+        const uint64 mid1 = (a >> 32) * (b & mask);
+        const uint64 mid2 = (a & mask) * (b >> 32);
+        const uint64 middle = (low >> 32) + (mid1 & mask) + (mid2 & mask);
+        hi = (a >> 32) * (b >> 32) + (mid1 >> 32) + (mid2 >> 32) + (middle >> 32);
+        return (middle << 32) | (low & mask);
+#endif
+    }
 
-            // minimalize value2 & divisor
-            c = gcd(value2dec, divisor);
-            if (c != 1) {
-                value2dec /= c;
-                divisor /= c;
+    // quotient = (hi * 2^64 + lo) / divisor, requires hi < divisor
+    static DEC_CONSTEXPR14 uint64 udiv128(uint64 hi, uint64 lo, uint64 divisor,
+            uint64 &remainder) {
+#ifdef DEC_USE_DIVQ
+        if (!DEC_IS_CONSTANT_EVALUATED()) {
+            return udiv128_divq(hi, lo, divisor, remainder);
+        }
+#endif
+#ifdef DEC_HAS_INT128
+        const uint128 dividend = (static_cast<uint128>(hi) << 64) | lo;
+        remainder = static_cast<uint64>(dividend % divisor);
+        return static_cast<uint64>(dividend / divisor);
+#else
+        // shift-subtract division, hi is kept below divisor
+        uint64 quotient = 0;
+        for (int i = 0; i < 64; ++i) {
+            const bool carry = (hi >> 63) != 0;
+            hi = (hi << 1) | (lo >> 63);
+            lo <<= 1;
+            quotient <<= 1;
+            if (carry || (hi >= divisor)) {
+                hi -= divisor;
+                quotient |= 1;
             }
         }
+        remainder = hi;
+        return quotient;
+#endif
+    }
 
-        if (!isMultOverflow(value1dec, value2dec)) { // no overflow
-            int64 resDecPart = value1dec * value2dec;
-            if (RoundPolicy::div_rounded(resDecPart, resDecPart, divisor)) {
-                result += resDecPart;
-                return result;
+#ifdef DEC_USE_DIVQ
+    static uint64 udiv128_divq(uint64 hi, uint64 lo, uint64 divisor,
+            uint64 &remainder) {
+        uint64 quotient;
+        __asm__("divq %4" : "=a"(quotient), "=d"(remainder) : "a"(lo), "d"(hi), "rm"(divisor));
+        return quotient;
+    }
+#endif
+
+    // absolute value as unsigned, valid also for DEC_MIN_INT64
+    static DEC_CONSTEXPR uint64 uabs(const int64 value) {
+        return (value < 0) ? (0 - static_cast<uint64>(value)) : static_cast<uint64>(value);
+    }
+
+#ifdef DEC_HAS_INT128
+    // result = value * factor, where value is first replaced by the shortest decimal
+    // which converts back to the same double (as printed by Ryu or Grisu) and then
+    // rounded to integer using RoundPolicy. Only integer arithmetic is used.
+    // Returns false if value is not finite or result does not fit in int64.
+    static bool fromDouble(double value, uint64 factor, int64 &result) {
+        result = 0;
+        if (value == 0) {
+            return true;
+        }
+        if (!(value - value == 0)) {
+            return false; // NaN or infinity
+        }
+
+        const bool negative = value < 0;
+        const int digits = std::numeric_limits<double>::digits;
+        int exponent = 0;
+        const double fraction = std::frexp(negative ? -value : value, &exponent);
+        // |value| = mantissa * 2^exponent
+        const uint64 mantissa = static_cast<uint64>(std::ldexp(fraction, digits));
+        exponent -= digits;
+        if (exponent > 63 - digits) {
+            return false; // |value| >= 2^63
+        }
+
+        const int shift = (exponent < 0) ? -exponent : 0;
+        if (shift > 120) {
+            // |value * factor| < 2^-7, shortest decimal is not on a multiple of 1/10
+            return roundQuotient(negative, 0, 1, 4, result);
+        }
+
+        // Integers below are scaled by 20 * 2^shift, so that both ends of rounding
+        // interval of value (+/- half of ulp) and multiples of 1/10 are integers.
+        // Interval is narrower below powers of 2, ends belong to it for even mantissa
+        // (round half to even is used when decimal is converted to double).
+        const int up = exponent + shift;
+        const uint128 product = (static_cast<uint128>(mantissa) << up) * factor;
+        if ((product >> shift) > static_cast<uint128>(DEC_MAX_INT64) + 1) {
+            return false;
+        }
+        const uint128 scaled = product * 20;
+        const uint128 above = (static_cast<uint128>(factor) << up) * 10;
+        const uint128 below = (mantissa == (static_cast<uint64>(1) << (digits - 1))) ? above / 2 : above;
+        const bool inclusive = (mantissa % 2) == 0;
+        const uint128 unitStep = static_cast<uint128>(20) << shift;
+
+        // shortest decimal: largest multiple of 10^n units found in interval,
+        // several multiples can be found only if interval is wider than unit
+        uint128 multiple = 0;
+        for (int n = (above * 2 >= unitStep) ? max_decimal_points : 0; n >= 0; --n) {
+            if (nearestMultiple(scaled, unitStep * pow10(n), below, above, inclusive, multiple)) {
+                return roundQuotient(negative, static_cast<uint64>(multiple * pow10(n)), 0, 1, result);
             }
         }
 
-        // overflow can occur - use less precise version
-        result += RoundPolicy::round(
-                static_cast<cross_float>(value1dec)
-                        * static_cast<cross_float>(value2dec)
-                        / static_cast<cross_float>(divisor));
-        return result;
+        if (nearestMultiple(scaled, unitStep / 10, below, above, inclusive, multiple)) {
+            return roundQuotient(negative, static_cast<uint64>(multiple / 10),
+                    static_cast<uint64>(multiple % 10), 10, result);
+        }
+
+        // shortest decimal has more digits and is on the same side of half of unit as value
+        const uint128 remainder = scaled % unitStep;
+        return roundQuotient(negative, static_cast<uint64>(scaled / unitStep),
+                (remainder * 2 < unitStep) ? 1 : 3, 4, result);
+    }
+
+    // value / factor correctly rounded to the nearest double (ties to even),
+    // requires factor <= 10^18
+    static double toDouble(int64 value, uint64 factor) {
+        const uint64 absValue = uabs(value);
+        if (absValue <= (static_cast<uint64>(1) << std::numeric_limits<double>::digits)) {
+            // both operands are exact, so result of division is rounded once
+            return static_cast<double>(value) / static_cast<double>(factor);
+        }
+
+        // quotient with 55 or more significant bits and sticky bit, then rounded to 53 bits
+        const int valueBits = 64 - __builtin_clzll(absValue);
+        const int factorBits = 64 - __builtin_clzll(factor);
+        const int shift = (55 + factorBits > valueBits) ? 55 + factorBits - valueBits : 0;
+        const uint128 dividend = static_cast<uint128>(absValue) << shift;
+        const uint64 quotient = static_cast<uint64>(dividend / factor);
+        const bool sticky = (dividend % factor) != 0;
+
+        const int extraBits = 64 - __builtin_clzll(quotient) - std::numeric_limits<double>::digits;
+        const uint64 half = static_cast<uint64>(1) << (extraBits - 1);
+        const uint64 rest = quotient & ((half << 1) - 1);
+        uint64 rounded = quotient >> extraBits;
+        if ((rest > half) || ((rest == half) && (sticky || ((rounded & 1) != 0)))) {
+            ++rounded;
+        }
+
+        const double result = std::ldexp(static_cast<double>(rounded), extraBits - shift);
+        return (value < 0) ? -result : result;
+    }
+#endif // DEC_HAS_INT128
+
+    // result = value1 + value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool addOverflow(const int64 value1, const int64 value2, int64 &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_add_overflow(value1, value2, &result);
+#else
+        result = static_cast<int64>(static_cast<uint64>(value1) + static_cast<uint64>(value2));
+        return ((value1 < 0) == (value2 < 0)) && ((result < 0) != (value1 < 0));
+#endif
+    }
+
+    // result = value1 - value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool subOverflow(const int64 value1, const int64 value2, int64 &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_sub_overflow(value1, value2, &result);
+#else
+        result = static_cast<int64>(static_cast<uint64>(value1) - static_cast<uint64>(value2));
+        return ((value1 < 0) != (value2 < 0)) && ((result < 0) != (value1 < 0));
+#endif
+    }
+
+    // result = value1 * value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool mulOverflow(const int64 value1, const int64 value2, int64 &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_mul_overflow(value1, value2, &result);
+#else
+        result = static_cast<int64>(static_cast<uint64>(value1) * static_cast<uint64>(value2));
+        return isMultOverflow(value1, value2);
+#endif
+    }
+
+    // result = (value1 * value2) / divisor as in multDiv(), returns true if exact result
+    // does not fit in int64 (result is then wrapped, see multDivWrapped)
+    DEC_CONSTEXPR14 static bool multDivOverflow(const int64 value1, const int64 value2,
+            const int64 divisor, int64 &result) {
+        if (multDiv128(value1, value2, divisor, result)) {
+            return false;
+        }
+        // division by zero fails here, as in unchecked version
+        result = multDivWrapped(value1, value2, divisor);
+        return true;
     }
 
-    static bool isMultOverflow(const int64 value1, const int64 value2) {
+    static DEC_CONSTEXPR14 bool isMultOverflow(const int64 value1, const int64 value2) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+       int64 result = 0;
+       return __builtin_mul_overflow(value1, value2, &result);
+#else
        if (value1 == 0 || value2 == 0) {
            return false;
        }
@@ -287,8 +701,14 @@ public:
        }
 
        return (value1 > DEC_MAX_INT64 / value2);
+#endif
     }
 
+#ifndef DEC_NO_CPP11
+    static DEC_CONSTEXPR int64 pow10(int n) {
+        return (n >= 0 && n <= max_decimal_points) ? decimalFactorTable[n] : 0;
+    }
+#else
     static int64 pow10(int n) {
         static const int64 decimalFactorTable[] = { 1, 10, 100, 1000, 10000,
                 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000,
@@ -302,6 +722,7 @@ public:
             return 0;
         }
     }
+#endif
 
     template<class T>
     static int64 trunc(T value) {
@@ -309,9 +730,31 @@ public:
     }
 
 private:
+#ifdef DEC_HAS_INT128
+    // multiple = k, where k * step is the nearest to value within
+    // [value - below, value + above], returns false if there is no such k
+    static bool nearestMultiple(uint128 value, uint128 step, uint128 below, uint128 above,
+            bool inclusive, uint128 &multiple) {
+        multiple = value / step;
+        const uint128 lowerDistance = value - multiple * step;
+        const uint128 upperDistance = step - lowerDistance;
+        const bool lowerFound = inclusive ? (lowerDistance <= below) : (lowerDistance < below);
+        const bool upperFound = inclusive ? (upperDistance <= above) : (upperDistance < above);
+        if (lowerDistance == 0) {
+            return true;
+        }
+        if (upperFound && (!lowerFound || (upperDistance < lowerDistance)
+                || ((upperDistance == lowerDistance) && ((multiple % 2) != 0)))) {
+            ++multiple;
+            return true;
+        }
+        return lowerFound;
+    }
+#endif
+
     // calculate greatest common divisor
-    static int64 gcd(int64 a, int64 b) {
-        int64 c;
+    static DEC_CONSTEXPR14 int64 gcd(int64 a, int64 b) {
+        int64 c = 0;
         while (a != 0) {
             c = a;
             a = b % a;
@@ -320,8 +763,20 @@ private:
         return b;
     }
 
+#ifndef DEC_NO_CPP11
+    static constexpr int64 decimalFactorTable[max_decimal_points + 1] = { 1, 10,
+            100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+            10000000000, 100000000000, 1000000000000, 10000000000000,
+            100000000000000, 1000000000000000, 10000000000000000,
+            100000000000000000, 1000000000000000000 };
+#endif
 };
 
+#ifndef DEC_NO_CPP11
+template<class RoundPolicy>
+constexpr int64 dec_utils<RoundPolicy>::decimalFactorTable[max_decimal_points + 1];
+#endif
+
 // no-rounding policy (decimal places stripped)
 class null_round_policy {
 public:
@@ -330,10 +785,17 @@ public:
         return static_cast<int64>(value);
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
         output = a / b;
         return true;
     }
+
+    // Decides if truncated quotient (magnitude) needs to be moved one step away from zero.
+    // All arguments are absolute values, remainder < divisor.
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool, T, T, T) {
+        return false;
+    }
 };
 
 // default rounding policy - arithmetic, to nearest integer
@@ -344,8 +806,13 @@ public:
         return DEC_NAMESPACE::round(value);
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        return DEC_NAMESPACE::div_rounded(output, a, b);
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<def_round_policy>::divRounded(output, a, b);
+    }
+
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool, T, T remainder, T divisor) {
+        return remainder >= divisor - remainder;
     }
 };
 
@@ -375,28 +842,13 @@ public:
         return static_cast<int64>(floor(val1));
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 divisorCorr = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
-
-        if (a >= 0) {
-            if (DEC_MAX_INT64 - a >= divisorCorr) {
-                if (remainder > divisorCorr) {
-                    output = (a + divisorCorr) / b;
-                } else {
-                    output = a / b;
-                }
-                return true;
-            }
-        } else {
-            if (-(DEC_MIN_INT64 - a) >= divisorCorr) {
-                output = (a - divisorCorr) / b;
-                return true;
-            }
-        }
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<half_down_round_policy>::divRounded(output, a, b);
+    }
 
-        output = 0;
-        return false;
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool negative, T, T remainder, T divisor) {
+        return negative ? (remainder >= divisor - remainder) : (remainder > divisor - remainder);
     }
 };
 
@@ -426,34 +878,13 @@ public:
         return static_cast<int64>(floor(val1));
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 divisorCorr = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
-
-        if (a >= 0) {
-            if (DEC_MAX_INT64 - a >= divisorCorr) {
-                if (remainder >= divisorCorr) {
-                    output = (a + divisorCorr) / b;
-                } else {
-                    output = a / b;
-                }
-                return true;
-            }
-        } else {
-            if (-(DEC_MIN_INT64 - a) >= divisorCorr) {
-                if (remainder < divisorCorr) {
-                    output = (a - remainder) / b;
-                } else if (remainder == divisorCorr) {
-                    output = (a + divisorCorr) / b;
-                } else {
-                    output = (a + remainder - std::abs(b)) / b;
-                }
-                return true;
-            }
-        }
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<half_up_round_policy>::divRounded(output, a, b);
+    }
 
-        output = 0;
-        return false;
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool negative, T, T remainder, T divisor) {
+        return negative ? (remainder > divisor - remainder) : (remainder >= divisor - remainder);
     }
 };
 
@@ -498,45 +929,14 @@ public:
         return static_cast<int64>(val1);
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 divisorDiv2 = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
-
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-
-                if (remainder > divisorDiv2) {
-                    output = (a - remainder + std::abs(b)) / b;
-                } else if (remainder < divisorDiv2) {
-                    output = (a - remainder) / b;
-                } else {
-                    bool is_even = std::abs(a / b) % 2 == 0;
-                    if (is_even) {
-                        output = a / b;
-                    } else {
-                        output = (a - remainder + std::abs(b)) / b;
-                    }
-                }
-            } else {
-                // negative value
-                if (remainder > divisorDiv2) {
-                    output = (a + remainder - std::abs(b)) / b;
-                } else if (remainder < divisorDiv2) {
-                    output = (a + remainder) / b;
-                } else {
-                    bool is_even = std::abs(a / b) % 2 == 0;
-                    if (is_even) {
-                        output = a / b;
-                    } else {
-                        output = (a + remainder - std::abs(b)) / b;
-                    }
-                }
-            }
-        }
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<half_even_round_policy>::divRounded(output, a, b);
+    }
 
-        return true;
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool, T quotient, T remainder, T divisor) {
+        return (remainder > divisor - remainder)
+                || ((remainder == divisor - remainder) && ((quotient & 1) != 0));
     }
 };
 
@@ -548,18 +948,13 @@ public:
         return static_cast<int64>(ceil(value));
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-                output = (a + std::abs(b)) / b;
-            } else {
-                output = a / b;
-            }
-        }
-        return true;
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<ceiling_round_policy>::divRounded(output, a, b);
+    }
+
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool negative, T, T remainder, T) {
+        return !negative && (remainder != 0);
     }
 };
 
@@ -571,18 +966,13 @@ public:
         return static_cast<int64>(floor(value));
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-                output = (a - remainder) / b;
-            } else {
-                output = (a + remainder - std::abs(b)) / b;
-            }
-        }
-        return true;
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<floor_round_policy>::divRounded(output, a, b);
+    }
+
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool negative, T, T remainder, T) {
+        return negative && (remainder != 0);
     }
 };
 
@@ -602,104 +992,748 @@ public:
         }
     }
 
-    static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-                output = (a + std::abs(b)) / b;
-            } else {
-                output = (a - std::abs(b)) / b;
-            }
-        }
-        return true;
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, int64 a, int64 b) {
+        return dec_utils<round_up_round_policy>::divRounded(output, a, b);
+    }
+
+    template<class T>
+    static DEC_CONSTEXPR bool away_from_zero(bool, T, T remainder, T) {
+        return remainder != 0;
     }
 };
 
-template<int Prec, class RoundPolicy = def_round_policy>
-class decimal {
-public:
-    typedef dec_storage_t raw_data_t;
+// ----------------------------------------------------------------------------
+// Storage types
+// ----------------------------------------------------------------------------
+
+/// Properties of integer type used as decimal storage (see decimal::raw_data_t).
+/// Specialized for int64 (default), int32 and int128 (if supported by compiler).
+/// arithmetic_type is used for integer operands and intermediate values.
+template<class T>
+struct storage_traits;
+
+template<>
+struct storage_traits<int32> {
+    typedef uint32 unsigned_type;
+    typedef int64 arithmetic_type;
     enum {
-        decimal_points = Prec
+        // number of decimal digits which can be always stored
+        digits10 = 9,
+        max_decimal_points = 9,
+        // sign + digits + decimal point + decimal points
+        max_chars = 1 + 10 + 1 + max_decimal_points
     };
 
-    decimal() {
-        init(0);
-    }
-    decimal(const decimal &src) {
-        init(src);
-    }
-    explicit decimal(uint value) {
-        init(value);
+    static DEC_CONSTEXPR int32 max_value() {
+        return INT32_MAX;
     }
-    explicit decimal(int value) {
-        init(value);
-    }
-    explicit decimal(int64 value) {
-        init(value);
+
+    static DEC_CONSTEXPR int32 min_value() {
+        return INT32_MIN;
     }
-    explicit decimal(xdouble value) {
-        init(value);
+
+    static DEC_CONSTEXPR int32 pow10(int n) {
+        return (n >= 0 && n <= max_decimal_points) ?
+                static_cast<int32>(dec_utils<def_round_policy>::pow10(n)) : 0;
     }
-    explicit decimal(double value) {
-        init(value);
+};
+
+template<>
+struct storage_traits<int64> {
+    typedef uint64 unsigned_type;
+    typedef int64 arithmetic_type;
+    enum {
+        // number of decimal digits which can be always stored
+        digits10 = 18,
+        max_decimal_points = 18,
+        // sign + digits + decimal point + decimal points
+        max_chars = 1 + 19 + 1 + max_decimal_points
+    };
+
+    static DEC_CONSTEXPR int64 max_value() {
+        return DEC_MAX_INT64;
     }
-    explicit decimal(float value) {
-        init(value);
+
+    static DEC_CONSTEXPR int64 min_value() {
+        return DEC_MIN_INT64;
     }
-    explicit decimal(int64 value, int64 precFactor) {
-        initWithPrec(value, precFactor);
+
+    static DEC_CONSTEXPR int64 pow10(int n) {
+        return dec_utils<def_round_policy>::pow10(n);
     }
-    explicit decimal(const std::string &value) {
-        fromString(value, *this);
+};
+
+#ifdef DEC_HAS_INT128
+namespace details {
+
+// template only to allow definition of table in header
+template<int Dummy>
+struct int128_factor_table {
+#ifndef DEC_NO_CPP11
+    static constexpr uint128 p19 = 10000000000000000000ULL;
+    static constexpr int128 values[39] = { 1, 10, 100, 1000, 10000, 100000,
+            1000000, 10000000, 100000000, 1000000000, 10000000000,
+            100000000000, 1000000000000, 10000000000000, 100000000000000,
+            1000000000000000, 10000000000000000, 100000000000000000,
+            1000000000000000000, static_cast<int128>(p19),
+            static_cast<int128>(p19 * 10), static_cast<int128>(p19 * 100),
+            static_cast<int128>(p19 * 1000), static_cast<int128>(p19 * 10000),
+            static_cast<int128>(p19 * 100000), static_cast<int128>(p19 * 1000000),
+            static_cast<int128>(p19 * 10000000), static_cast<int128>(p19 * 100000000),
+            static_cast<int128>(p19 * 1000000000), static_cast<int128>(p19 * 10000000000ULL),
+            static_cast<int128>(p19 * 100000000000ULL),
+            static_cast<int128>(p19 * 1000000000000ULL),
+            static_cast<int128>(p19 * 10000000000000ULL),
+            static_cast<int128>(p19 * 100000000000000ULL),
+            static_cast<int128>(p19 * 1000000000000000ULL),
+            static_cast<int128>(p19 * 10000000000000000ULL),
+            static_cast<int128>(p19 * 100000000000000000ULL),
+            static_cast<int128>(p19 * 1000000000000000000ULL),
+            static_cast<int128>(p19 * 10000000000000000000ULL) };
+#endif
+};
+
+#ifndef DEC_NO_CPP11
+template<int Dummy>
+constexpr uint128 int128_factor_table<Dummy>::p19;
+template<int Dummy>
+constexpr int128 int128_factor_table<Dummy>::values[39];
+#endif
+
+} // namespace details
+
+template<>
+struct storage_traits<int128> {
+    typedef uint128 unsigned_type;
+    typedef int128 arithmetic_type;
+    enum {
+        // number of decimal digits which can be always stored
+        digits10 = 38,
+        max_decimal_points = 38,
+        // sign + digits + decimal point + decimal points
+        max_chars = 1 + 39 + 1 + max_decimal_points
+    };
+
+    static DEC_CONSTEXPR int128 max_value() {
+        return static_cast<int128>(~static_cast<uint128>(0) >> 1);
     }
 
-    ~decimal() {
+    static DEC_CONSTEXPR int128 min_value() {
+        return -max_value() - 1;
     }
 
-    static int64 getPrecFactor() {
-        return DecimalFactor<Prec>::value;
+    static DEC_CONSTEXPR int128 pow10(int n) {
+        return (n >= 0 && n <= max_decimal_points) ?
+                details::int128_factor_table<0>::values[n] : 0;
     }
-    static int getDecimalPoints() {
-        return Prec;
+};
+#endif // DEC_HAS_INT128
+
+/// Arithmetic on decimal storage of type T (signed integer wider than int64).
+/// Results of multiplication & division are calculated exactly (with
+/// intermediate value twice as wide as T) and rounded once using
+/// RoundPolicy::away_from_zero.
+template<class RoundPolicy, class T>
+class storage_utils {
+public:
+    typedef typename storage_traits<T>::unsigned_type unsigned_type;
+
+    static DEC_CONSTEXPR T pow10(int n) {
+        return storage_traits<T>::pow10(n);
     }
 
-    decimal & operator=(const decimal &rhs) {
-        if (&rhs != this)
-            m_value = rhs.m_value;
-        return *this;
+    // absolute value as unsigned, valid also for minimal value
+    static DEC_CONSTEXPR unsigned_type uabs(const T value) {
+        return (value < 0) ? (0 - static_cast<unsigned_type>(value))
+                : static_cast<unsigned_type>(value);
+    }
+
+    // result = value1 + value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool addOverflow(const T value1, const T value2, T &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_add_overflow(value1, value2, &result);
+#else
+        result = static_cast<T>(static_cast<unsigned_type>(value1)
+                + static_cast<unsigned_type>(value2));
+        return ((value1 < 0) == (value2 < 0)) && ((result < 0) != (value1 < 0));
+#endif
+    }
+
+    // result = value1 - value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool subOverflow(const T value1, const T value2, T &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_sub_overflow(value1, value2, &result);
+#else
+        result = static_cast<T>(static_cast<unsigned_type>(value1)
+                - static_cast<unsigned_type>(value2));
+        return ((value1 < 0) != (value2 < 0)) && ((result < 0) != (value1 < 0));
+#endif
+    }
+
+    // result = value1 * value2 (wrapped on overflow), returns true on overflow
+    static DEC_CONSTEXPR14 bool mulOverflow(const T value1, const T value2, T &result) {
+#ifdef DEC_HAS_BUILTIN_OVERFLOW
+        return __builtin_mul_overflow(value1, value2, &result);
+#else
+        const bool negative = (value1 < 0) != (value2 < 0);
+        const unsigned_type abs1 = uabs(value1);
+        const unsigned_type abs2 = uabs(value2);
+        const unsigned_type limit = static_cast<unsigned_type>(storage_traits<T>::max_value())
+                + (negative ? 1 : 0);
+        result = static_cast<T>(static_cast<unsigned_type>(value1)
+                * static_cast<unsigned_type>(value2));
+        return (abs1 != 0) && (abs2 > limit / abs1);
+#endif
+    }
+
+    // output = a / b rounded using RoundPolicy, false if result does not fit in T
+    static DEC_CONSTEXPR14 bool div_rounded(T &output, const T a, const T b) {
+        const unsigned_type absValue = uabs(a);
+        const unsigned_type absDivisor = uabs(b);
+        if (!roundQuotient((a < 0) != (b < 0), absValue / absDivisor,
+                absValue % absDivisor, absDivisor, output)) {
+            output = 0;
+            return false;
+        }
+        return true;
+    }
+
+    // output = a / 10^N rounded using RoundPolicy
+    template<int N>
+    static DEC_CONSTEXPR14 bool div_rounded_pow10(T &output, const T a) {
+        return div_rounded(output, a, pow10(N));
+    }
+
+    // result = (value1 * value2) / divisor, result is undefined on overflow
+    static DEC_CONSTEXPR14 T multDiv(const T value1, const T value2, const T divisor) {
+        T result = 0;
+        multDivOverflow(value1, value2, divisor, result);
+        return result;
+    }
+
+    // result = (value1 * value2) / divisor calculated with double-width intermediate
+    // value and a single rounded division, returns true if result does not fit in T
+    static DEC_CONSTEXPR14 bool multDivOverflow(const T value1, const T value2,
+            const T divisor, T &result) {
+        unsigned_type hi = 0;
+        unsigned_type lo = 0;
+        multWide(uabs(value1), uabs(value2), hi, lo);
+        const unsigned_type absDivisor = uabs(divisor);
+        const bool negative = ((value1 < 0) != (value2 < 0)) != (divisor < 0);
+
+        unsigned_type quotient = 0;
+        unsigned_type remainder = 0;
+        if (hi == 0) {
+            // the next line fails on division by zero
+            quotient = lo / absDivisor;
+            remainder = lo % absDivisor;
+        } else if (hi < absDivisor) {
+            quotient = divWide(hi, lo, absDivisor, remainder);
+        } else {
+            // quotient does not fit in unsigned_type
+            result = static_cast<T>(negative ? 0 - lo : lo);
+            return true;
+        }
+
+        if (!roundQuotient(negative, quotient, remainder, absDivisor, result)) {
+            result = static_cast<T>(negative ? 0 - quotient : quotient);
+            return true;
+        }
+        return false;
+    }
+
+    // result = +/- (quotient rounded using remainder), false if result does not fit in T
+    static DEC_CONSTEXPR14 bool roundQuotient(bool negative, unsigned_type quotient,
+            unsigned_type remainder, unsigned_type divisor, T &result) {
+        const unsigned_type limit = static_cast<unsigned_type>(storage_traits<T>::max_value())
+                + (negative ? 1 : 0);
+
+        if (RoundPolicy::away_from_zero(negative, quotient, remainder, divisor)) {
+            if (quotient >= limit) {
+                return false;
+            }
+            ++quotient;
+        } else if (quotient > limit) {
+            return false;
+        }
+
+        result = static_cast<T>(negative ? 0 - quotient : quotient);
+        return true;
+    }
+
+    // value with precision of fromFactor converted to precision of toFactor
+    static DEC_CONSTEXPR14 T rescale(T value, T fromFactor, T toFactor) {
+        return multDiv(value, toFactor, fromFactor);
+    }
+
+    // floating point value multiplied by factor and rounded, result is undefined on overflow
+    template<typename F>
+    static T fromFloat(F value, T factor) {
+        T result = 0;
+        fromFloatOverflow(value, factor, result);
+        return result;
+    }
+
+    // floating point value multiplied by factor and rounded, returns true if value
+    // is not finite or result does not fit in T (result is then 0)
+    template<typename F>
+    static bool fromFloatOverflow(F value, T factor, T &result) {
+        const F limit = static_cast<F>(static_cast<unsigned_type>(1) << (sizeof(T) * 8 - 1));
+        const F scaled = value * static_cast<F>(factor);
+        // false also for NaN
+        if (!((scaled >= -limit) && (scaled < limit))) {
+            result = 0;
+            return true;
+        }
+        const T intPart = static_cast<T>(scaled);
+        // rounding of fraction only, parity is kept for half-even rounding
+        const int64 parity = static_cast<int64>(intPart % 2);
+        if (addOverflow(intPart - parity, static_cast<T>(RoundPolicy::round(
+                static_cast<F>(parity) + (scaled - static_cast<F>(intPart)))), result)) {
+            result = 0;
+            return true;
+        }
+        return false;
+    }
+
+    static double toDouble(T value, T factor) {
+        return static_cast<double>(value) / static_cast<double>(factor);
+    }
+
+private:
+    enum {
+        half_bits = sizeof(unsigned_type) * 4
+    };
+
+    // hi * 2^bits + lo = value1 * value2
+    static DEC_CONSTEXPR14 void multWide(const unsigned_type value1,
+            const unsigned_type value2, unsigned_type &hi, unsigned_type &lo) {
+        const unsigned_type mask = (static_cast<unsigned_type>(1) << half_bits) - 1;
+        const unsigned_type a0 = value1 & mask;
+        const unsigned_type a1 = value1 >> half_bits;
+        const unsigned_type b0 = value2 & mask;
+        const unsigned_type b1 = value2 >> half_bits;
+
+        const unsigned_type p00 = a0 * b0;
+        const unsigned_type p01 = a0 * b1;
+        const unsigned_type p10 = a1 * b0;
+        const unsigned_type p11 = a1 * b1;
+
+        // sum of middle parts can't overflow: at most 3 * (2^half_bits - 1)^2
+        const unsigned_type middle = (p00 >> half_bits) + (p01 & mask) + (p10 & mask);
+        lo = (middle << half_bits) | (p00 & mask);
+        hi = p11 + (p01 >> half_bits) + (p10 >> half_bits) + (middle >> half_bits);
+    }
+
+    // quotient = (hi * 2^bits + lo) / divisor, requires hi < divisor
+    static DEC_CONSTEXPR14 unsigned_type divWide(unsigned_type hi, unsigned_type lo,
+            const unsigned_type divisor, unsigned_type &remainder) {
+        const unsigned_type mask = (static_cast<unsigned_type>(1) << half_bits) - 1;
+        if (divisor <= mask) {
+            // two steps, each with half-width quotient
+            const unsigned_type part1 = (hi << half_bits) | (lo >> half_bits);
+            const unsigned_type q1 = part1 / divisor;
+            const unsigned_type part0 = ((part1 % divisor) << half_bits) | (lo & mask);
+            remainder = part0 % divisor;
+            return (q1 << half_bits) | (part0 / divisor);
+        }
+
+        // shift-subtract division, hi is kept below divisor
+        unsigned_type quotient = 0;
+        for (int i = 0; i < half_bits * 2; ++i) {
+            const bool carry = (hi >> (half_bits * 2 - 1)) != 0;
+            hi = (hi << 1) | (lo >> (half_bits * 2 - 1));
+            lo <<= 1;
+            quotient <<= 1;
+            if (carry || (hi >= divisor)) {
+                hi -= divisor;
+                quotient |= 1;
+            }
+        }
+        remainder = hi;
+        return quotient;
+    }
+};
+
+/// Storage arithmetic for int64, uses dec_utils and RoundPolicy::div_rounded.
+template<class RoundPolicy>
+class storage_utils<RoundPolicy, int64> {
+public:
+    typedef uint64 unsigned_type;
+
+    static DEC_CONSTEXPR int64 pow10(int n) {
+        return dec_utils<RoundPolicy>::pow10(n);
+    }
+
+    static DEC_CONSTEXPR uint64 uabs(const int64 value) {
+        return dec_utils<RoundPolicy>::uabs(value);
+    }
+
+    static DEC_CONSTEXPR14 bool addOverflow(const int64 value1, const int64 value2, int64 &result) {
+        return dec_utils<RoundPolicy>::addOverflow(value1, value2, result);
+    }
+
+    static DEC_CONSTEXPR14 bool subOverflow(const int64 value1, const int64 value2, int64 &result) {
+        return dec_utils<RoundPolicy>::subOverflow(value1, value2, result);
+    }
+
+    static DEC_CONSTEXPR14 bool mulOverflow(const int64 value1, const int64 value2, int64 &result) {
+        return dec_utils<RoundPolicy>::mulOverflow(value1, value2, result);
+    }
+
+    static DEC_CONSTEXPR14 bool div_rounded(int64 &output, const int64 a, const int64 b) {
+        return RoundPolicy::div_rounded(output, a, b);
+    }
+
+    template<int N>
+    static DEC_CONSTEXPR14 bool div_rounded_pow10(int64 &output, const int64 a) {
+        return dec_utils<RoundPolicy>::template div_rounded_pow10<N>(output, a);
+    }
+
+    static DEC_CONSTEXPR14 int64 multDiv(const int64 value1, const int64 value2,
+            const int64 divisor) {
+        return dec_utils<RoundPolicy>::multDiv(value1, value2, divisor);
+    }
+
+    static DEC_CONSTEXPR14 bool multDivOverflow(const int64 value1, const int64 value2,
+            const int64 divisor, int64 &result) {
+        return dec_utils<RoundPolicy>::multDivOverflow(value1, value2, divisor, result);
+    }
+
+    // value with precision of fromFactor converted to precision of toFactor,
+    // exact when one (positive) factor is a multiple of the other (e.g. powers of 10)
+    static DEC_CONSTEXPR14 int64 rescale(int64 value, int64 fromFactor, int64 toFactor) {
+        if ((fromFactor > 0) && (toFactor > 0)) {
+            if (toFactor % fromFactor == 0) {
+                return value * (toFactor / fromFactor);
+            }
+            if (fromFactor % toFactor == 0) {
+                const uint64 divisor = static_cast<uint64>(fromFactor / toFactor);
+                const uint64 absValue = uabs(value);
+                int64 result = 0;
+                // divisor > 1, so result always fits
+                dec_utils<RoundPolicy>::roundQuotient(value < 0, absValue / divisor,
+                        absValue % divisor, divisor, result);
+                return result;
+            }
+        }
+        return dec_utils<RoundPolicy>::multDiv(value, toFactor, fromFactor);
+    }
+
+    // floating point value multiplied by factor and rounded, result is undefined on overflow
+    template<typename F>
+    static int64 fromFloat(F value, int64 factor) {
+        int64 result = 0;
+        fromFloatOverflow(value, factor, result);
+        return result;
+    }
+
+    // floating point value multiplied by factor and rounded, returns true if value
+    // is not finite or result does not fit in int64 (result is then 0)
+    template<typename F>
+    static bool fromFloatOverflow(F value, int64 factor, int64 &result) {
+        const F limit = static_cast<F>(static_cast<uint64>(1) << 63);
+        const F scaled = value * static_cast<F>(factor);
+        // false also for NaN, integer part multiplied by factor fits in int64 below
+        if (!((scaled >= -limit) && (scaled < limit))) {
+            result = 0;
+            return true;
+        }
+        const int64 intPart = dec_utils<RoundPolicy>::trunc(value);
+        const F fracPart = value - intPart;
+        if (dec_utils<RoundPolicy>::addOverflow(RoundPolicy::round(static_cast<F>(factor) * fracPart),
+                factor * intPart, result)) {
+            result = 0;
+            return true;
+        }
+        return false;
+    }
+
+#ifdef DEC_HAS_INT128
+    // shortest decimal representation of value rounded to multiple of 1/factor,
+    // result is undefined on overflow
+    static int64 fromFloat(double value, int64 factor) {
+        int64 result = 0;
+        fromFloatOverflow(value, factor, result);
+        return result;
+    }
+
+    // as fromFloat(double, int64), returns true if value is not finite or result
+    // does not fit in int64 (result is then 0)
+    static bool fromFloatOverflow(double value, int64 factor, int64 &result) {
+        return !dec_utils<RoundPolicy>::fromDouble(value, static_cast<uint64>(factor), result);
+    }
+
+    static double toDouble(int64 value, int64 factor) {
+        return dec_utils<RoundPolicy>::toDouble(value, static_cast<uint64>(factor));
+    }
+#else
+    static double toDouble(int64 value, int64 factor) {
+        return static_cast<double>(value) / static_cast<double>(factor);
+    }
+#endif
+};
+
+/// Storage arithmetic for int32: operands are int64, results are calculated
+/// with int64 arithmetic (dec_utils) and then narrowed with range check.
+template<class RoundPolicy>
+class storage_utils<RoundPolicy, int32> {
+public:
+    typedef uint32 unsigned_type;
+
+    static DEC_CONSTEXPR int32 pow10(int n) {
+        return storage_traits<int32>::pow10(n);
+    }
+
+    static DEC_CONSTEXPR uint32 uabs(const int32 value) {
+        return (value < 0) ? (0 - static_cast<uint32>(value)) : static_cast<uint32>(value);
+    }
+
+    // result = value (wrapped if out of range), returns true if value does not fit in int32
+    static DEC_CONSTEXPR14 bool narrowOverflow(const int64 value, int32 &result) {
+        result = static_cast<int32>(static_cast<uint32>(value));
+        return result != value;
+    }
+
+    static DEC_CONSTEXPR14 bool addOverflow(const int64 value1, const int64 value2, int32 &result) {
+        int64 wide = 0;
+        const bool overflow = dec_utils<RoundPolicy>::addOverflow(value1, value2, wide);
+        return narrowOverflow(wide, result) || overflow;
+    }
+
+    static DEC_CONSTEXPR14 bool subOverflow(const int64 value1, const int64 value2, int32 &result) {
+        int64 wide = 0;
+        const bool overflow = dec_utils<RoundPolicy>::subOverflow(value1, value2, wide);
+        return narrowOverflow(wide, result) || overflow;
     }
 
+    static DEC_CONSTEXPR14 bool mulOverflow(const int64 value1, const int64 value2, int32 &result) {
+        int64 wide = 0;
+        const bool overflow = dec_utils<RoundPolicy>::mulOverflow(value1, value2, wide);
+        return narrowOverflow(wide, result) || overflow;
+    }
+
+    static DEC_CONSTEXPR14 bool div_rounded(int32 &output, const int64 a, const int64 b) {
+        int64 wide = 0;
+        if (!RoundPolicy::div_rounded(wide, a, b) || narrowOverflow(wide, output)) {
+            output = 0;
+            return false;
+        }
+        return true;
+    }
+
+    template<int N>
+    static DEC_CONSTEXPR14 bool div_rounded_pow10(int32 &output, const int64 a) {
+        int64 wide = 0;
+        dec_utils<RoundPolicy>::template div_rounded_pow10<N>(wide, a);
+        if (narrowOverflow(wide, output)) {
+            output = 0;
+            return false;
+        }
+        return true;
+    }
+
+    static DEC_CONSTEXPR14 int32 multDiv(const int64 value1, const int64 value2,
+            const int64 divisor) {
+        int32 result = 0;
+        narrowOverflow(dec_utils<RoundPolicy>::multDiv(value1, value2, divisor), result);
+        return result;
+    }
+
+    static DEC_CONSTEXPR14 bool multDivOverflow(const int64 value1, const int64 value2,
+            const int64 divisor, int32 &result) {
+        int64 wide = 0;
+        const bool overflow = dec_utils<RoundPolicy>::multDivOverflow(value1, value2,
+                divisor, wide);
+        return narrowOverflow(wide, result) || overflow;
+    }
+
+    static DEC_CONSTEXPR14 int32 rescale(int64 value, int64 fromFactor, int64 toFactor) {
+        int32 result = 0;
+        narrowOverflow(storage_utils<RoundPolicy, int64>::rescale(value, fromFactor, toFactor),
+                result);
+        return result;
+    }
+
+    template<typename F>
+    static int32 fromFloat(F value, int64 factor) {
+        int32 result = 0;
+        narrowOverflow(storage_utils<RoundPolicy, int64>::fromFloat(value, factor), result);
+        return result;
+    }
+
+    template<typename F>
+    static bool fromFloatOverflow(F value, int64 factor, int32 &result) {
+        int64 wide = 0;
+        if (storage_utils<RoundPolicy, int64>::fromFloatOverflow(value, factor, wide)
+                || narrowOverflow(wide, result)) {
+            result = 0;
+            return true;
+        }
+        return false;
+    }
+
+    static double toDouble(int64 value, int64 factor) {
+        return storage_utils<RoundPolicy, int64>::toDouble(value, factor);
+    }
+};
+
+/// Overflow is not detected, result of overflowing operation is undefined (default).
+class unchecked_overflow_policy {
+public:
+    enum {
+        checked = 0
+    };
+
+    template<class T>
+    static DEC_CONSTEXPR T overflow(T uncheckedResult, bool) {
+        return uncheckedResult;
+    }
+};
+
+/// Overflow throws std::overflow_error.
+class throwing_overflow_policy {
+public:
+    enum {
+        checked = 1
+    };
+
+    template<class T>
+    static T overflow(T, bool) {
+        throw std::overflow_error("decimal overflow");
+    }
+};
+
+/// Overflowing result is replaced with the largest or the smallest value.
+class saturating_overflow_policy {
+public:
+    enum {
+        checked = 1
+    };
+
+    template<class T>
+    static DEC_CONSTEXPR T overflow(T, bool positive) {
+        return positive ? storage_traits<T>::max_value() : storage_traits<T>::min_value();
+    }
+};
+
+/// Overflowing result wraps around and sets a flag of the current thread,
+/// which stays set until clear() is called (like floating-point exception flags).
+class flagged_overflow_policy {
+public:
+    enum {
+        checked = 1
+    };
+
+    template<class T>
+    static T overflow(T uncheckedResult, bool) {
+        flag() = true;
+        return uncheckedResult;
+    }
+
+    /// Returns true if overflow occurred in current thread since last clear()
+    static bool test() {
+        return flag();
+    }
+
+    static void clear() {
+        flag() = false;
+    }
+
+private:
+    static bool &flag() {
+        static DEC_THREAD_LOCAL bool value = false;
+        return value;
+    }
+};
+
+template<int Prec, class RoundPolicy = def_round_policy,
+        class OverflowPolicy = unchecked_overflow_policy,
+        class StorageType = dec_storage_t>
+class decimal {
+public:
+    typedef StorageType raw_data_t;
+    typedef typename storage_traits<StorageType>::arithmetic_type arithmetic_t;
+    typedef RoundPolicy round_policy_t;
+    typedef OverflowPolicy overflow_policy_t;
+    enum {
+        decimal_points = Prec
+    };
+    static_assert((Prec >= 0) && (Prec <= storage_traits<StorageType>::max_decimal_points),
+            "decimal precision is out of range of storage type");
+
+    DEC_CONSTEXPR decimal() :
+            m_value(0) {
+    }
+#ifndef DEC_NO_CPP11
+    decimal(const decimal &src) = default;
+#endif
+    DEC_CONSTEXPR explicit decimal(uint value) :
+            m_value(fromInteger(static_cast<int64>(value))) {
+    }
+    DEC_CONSTEXPR explicit decimal(int value) :
+            m_value(fromInteger(value)) {
+    }
+    DEC_CONSTEXPR explicit decimal(int64 value) :
+            m_value(fromInteger(value)) {
+    }
+    explicit decimal(xdouble value) {
+        init(value);
+    }
+    explicit decimal(double value) {
+        init(value);
+    }
+    explicit decimal(float value) {
+        init(value);
+    }
+    explicit decimal(arithmetic_t value, arithmetic_t precFactor) {
+        initWithPrec(value, precFactor);
+    }
+    explicit decimal(const std::string &value) {
+        fromString(value, *this);
+    }
+    explicit decimal(const char *value) {
+        fromString(value, *this);
+    }
+
+    static DEC_CONSTEXPR raw_data_t getPrecFactor() {
+        return storage_utils_t::pow10(Prec);
+    }
+    static DEC_CONSTEXPR int getDecimalPoints() {
+        return Prec;
+    }
+
+#ifndef DEC_NO_CPP11
+    decimal & operator=(const decimal &rhs) = default;
+#endif
+
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 typename std::enable_if<Prec >= Prec2, decimal>::type
     & operator=(const decimal<Prec2> &rhs) {
-        m_value = rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
+        m_value = rhs.getUnbiased() * storage_traits<arithmetic_t>::pow10(Prec - Prec2);
         return *this;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    decimal & operator=(const decimal<Prec2> &rhs) {
+    DEC_CONSTEXPR14 decimal & operator=(const decimal<Prec2> &rhs) {
         if (Prec2 > Prec) {
-            RoundPolicy::div_rounded(m_value, rhs.getUnbiased(),
-                    DecimalFactorDiff<Prec2 - Prec>::value);
+            m_value = roundFromPrec<Prec2>(rhs.getUnbiased());
         } else {
             m_value = rhs.getUnbiased()
-                    * DecimalFactorDiff<Prec - Prec2>::value;
+                    * storage_traits<arithmetic_t>::pow10(Prec - Prec2);
         }
         return *this;
     }
 #endif
 
-    decimal & operator=(int64 rhs) {
-        m_value = DecimalFactor<Prec>::value * rhs;
+    DEC_CONSTEXPR14 decimal & operator=(int64 rhs) {
+        m_value = fromInteger(rhs);
         return *this;
     }
 
-    decimal & operator=(int rhs) {
-        m_value = DecimalFactor<Prec>::value * rhs;
+    DEC_CONSTEXPR14 decimal & operator=(int rhs) {
+        m_value = fromInteger(rhs);
         return *this;
     }
 
@@ -713,303 +1747,289 @@ public:
         return *this;
     }
 
-    bool operator==(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator==(const decimal &rhs) const {
         return (m_value == rhs.m_value);
     }
 
-    bool operator<(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator<(const decimal &rhs) const {
         return (m_value < rhs.m_value);
     }
 
-    bool operator<=(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator<=(const decimal &rhs) const {
         return (m_value <= rhs.m_value);
     }
 
-    bool operator>(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator>(const decimal &rhs) const {
         return (m_value > rhs.m_value);
     }
 
-    bool operator>=(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator>=(const decimal &rhs) const {
         return (m_value >= rhs.m_value);
     }
 
-    bool operator!=(const decimal &rhs) const {
+    DEC_CONSTEXPR bool operator!=(const decimal &rhs) const {
         return !(*this == rhs);
     }
 
-    const decimal operator+(const decimal &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator+(const decimal &rhs) const {
         decimal result = *this;
-        result.m_value += rhs.m_value;
+        result.m_value = checkedAdd(m_value, rhs.m_value);
         return result;
     }
 
 #if DEC_TYPE_LEVEL == 1
 template<int Prec2>
-    const typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 const typename std::enable_if<Prec >= Prec2, decimal>::type
     operator+(const decimal<Prec2> &rhs) const {
         decimal result = *this;
-        result.m_value += rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
+        result.m_value = checkedAdd(m_value,
+                checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         return result;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    const decimal operator+(const decimal<Prec2> &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator+(const decimal<Prec2> &rhs) const {
         decimal result = *this;
         if (Prec2 > Prec) {
-            int64 val;
-            RoundPolicy::div_rounded(val, rhs.getUnbiased(),
-                    DecimalFactorDiff<Prec2 - Prec>::value);
-            result.m_value += val;
+            const raw_data_t val = roundFromPrec<Prec2>(rhs.getUnbiased());
+            result.m_value = checkedAdd(m_value, val);
         } else {
-            result.m_value += rhs.getUnbiased()
-                    * DecimalFactorDiff<Prec - Prec2>::value;
+            result.m_value = checkedAdd(m_value,
+                    checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         }
 
         return result;
     }
 #endif
 
-    decimal & operator+=(const decimal &rhs) {
-        m_value += rhs.m_value;
+    DEC_CONSTEXPR14 decimal & operator+=(const decimal &rhs) {
+        m_value = checkedAdd(m_value, rhs.m_value);
         return *this;
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 typename std::enable_if<Prec >= Prec2, decimal>::type
     & operator+=(const decimal<Prec2> &rhs) {
-        m_value += rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
+        m_value = checkedAdd(m_value,
+                checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         return *this;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    decimal & operator+=(const decimal<Prec2> &rhs) {
+    DEC_CONSTEXPR14 decimal & operator+=(const decimal<Prec2> &rhs) {
         if (Prec2 > Prec) {
-            int64 val;
-            RoundPolicy::div_rounded(val, rhs.getUnbiased(),
-                    DecimalFactorDiff<Prec2 - Prec>::value);
-            m_value += val;
+            const raw_data_t val = roundFromPrec<Prec2>(rhs.getUnbiased());
+            m_value = checkedAdd(m_value, val);
         } else {
-            m_value += rhs.getUnbiased()
-                    * DecimalFactorDiff<Prec - Prec2>::value;
+            m_value = checkedAdd(m_value,
+                    checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         }
 
         return *this;
     }
 #endif
 
-    const decimal operator+() const {
+    DEC_CONSTEXPR const decimal operator+() const {
         return *this;
     }
 
-    const decimal operator-() const {
+    DEC_CONSTEXPR14 const decimal operator-() const {
         decimal result = *this;
-        result.m_value = -result.m_value;
+        result.m_value = checkedSub(0, m_value);
         return result;
     }
 
-    const decimal operator-(const decimal &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator-(const decimal &rhs) const {
         decimal result = *this;
-        result.m_value -= rhs.m_value;
+        result.m_value = checkedSub(m_value, rhs.m_value);
         return result;
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    const typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 const typename std::enable_if<Prec >= Prec2, decimal>::type
     operator-(const decimal<Prec2> &rhs) const {
         decimal result = *this;
-        result.m_value -= rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
+        result.m_value = checkedSub(m_value,
+                checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         return result;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    const decimal operator-(const decimal<Prec2> &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator-(const decimal<Prec2> &rhs) const {
         decimal result = *this;
         if (Prec2 > Prec) {
-            int64 val;
-            RoundPolicy::div_rounded(val, rhs.getUnbiased(),
-                    DecimalFactorDiff<Prec2 - Prec>::value);
-            result.m_value -= val;
+            const raw_data_t val = roundFromPrec<Prec2>(rhs.getUnbiased());
+            result.m_value = checkedSub(m_value, val);
         } else {
-            result.m_value -= rhs.getUnbiased()
-                    * DecimalFactorDiff<Prec - Prec2>::value;
+            result.m_value = checkedSub(m_value,
+                    checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         }
 
         return result;
     }
 #endif
 
-    decimal & operator-=(const decimal &rhs) {
-        m_value -= rhs.m_value;
+    DEC_CONSTEXPR14 decimal & operator-=(const decimal &rhs) {
+        m_value = checkedSub(m_value, rhs.m_value);
         return *this;
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 typename std::enable_if<Prec >= Prec2, decimal>::type
     & operator-=(const decimal<Prec2> &rhs) {
-        m_value -= rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
+        m_value = checkedSub(m_value,
+                checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         return *this;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    decimal & operator-=(const decimal<Prec2> &rhs) {
+    DEC_CONSTEXPR14 decimal & operator-=(const decimal<Prec2> &rhs) {
         if (Prec2 > Prec) {
-            int64 val;
-            RoundPolicy::div_rounded(val, rhs.getUnbiased(),
-                    DecimalFactorDiff<Prec2 - Prec>::value);
-            m_value -= val;
+            const raw_data_t val = roundFromPrec<Prec2>(rhs.getUnbiased());
+            m_value = checkedSub(m_value, val);
         } else {
-            m_value -= rhs.getUnbiased()
-                    * DecimalFactorDiff<Prec - Prec2>::value;
+            m_value = checkedSub(m_value,
+                    checkedMul(rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec - Prec2)));
         }
 
         return *this;
     }
 #endif
 
-    const decimal operator*(int rhs) const {
+    DEC_CONSTEXPR14 const decimal operator*(int rhs) const {
         decimal result = *this;
-        result.m_value *= rhs;
+        result.m_value = checkedMul(m_value, rhs);
         return result;
     }
 
-    const decimal operator*(int64 rhs) const {
+    DEC_CONSTEXPR14 const decimal operator*(int64 rhs) const {
         decimal result = *this;
-        result.m_value *= rhs;
+        result.m_value = checkedMul(m_value, rhs);
         return result;
     }
 
-    const decimal operator*(const decimal &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator*(const decimal &rhs) const {
         decimal result = *this;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                rhs.m_value, DecimalFactor<Prec>::value);
+        result.m_value = checkedMultDiv(m_value,
+                rhs.m_value, getPrecFactor());
         return result;
     }
 
-#if DEC_TYPE_LEVEL == 1
+#if (DEC_TYPE_LEVEL > 0) && defined(DEC_EXACT_MULT)
+    template<int Prec2>
+    DEC_CONSTEXPR14 const decimal<Prec + Prec2, RoundPolicy, OverflowPolicy, StorageType>
+    operator*(const decimal<Prec2>& rhs) const {
+        return exact_mult(*this, rhs);
+    }
+#elif DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    const typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 const typename std::enable_if<Prec >= Prec2, decimal>::type
     operator*(const decimal<Prec2>& rhs) const {
         decimal result = *this;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                rhs.getUnbiased(), DecimalFactor<Prec2>::value);
+        result.m_value = checkedMultDiv(result.m_value,
+                rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec2));
         return result;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    const decimal operator*(const decimal<Prec2>& rhs) const {
+    DEC_CONSTEXPR14 const decimal operator*(const decimal<Prec2>& rhs) const {
         decimal result = *this;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                rhs.getUnbiased(), DecimalFactor<Prec2>::value);
+        result.m_value = checkedMultDiv(result.m_value,
+                rhs.getUnbiased(), storage_traits<arithmetic_t>::pow10(Prec2));
         return result;
     }
 #endif
 
-    decimal & operator*=(int rhs) {
-        m_value *= rhs;
+    DEC_CONSTEXPR14 decimal & operator*=(int rhs) {
+        m_value = checkedMul(m_value, rhs);
         return *this;
     }
 
-    decimal & operator*=(int64 rhs) {
-        m_value *= rhs;
+    DEC_CONSTEXPR14 decimal & operator*=(int64 rhs) {
+        m_value = checkedMul(m_value, rhs);
         return *this;
     }
 
-    decimal & operator*=(const decimal &rhs) {
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value, rhs.m_value,
-                DecimalFactor<Prec>::value);
+    DEC_CONSTEXPR14 decimal & operator*=(const decimal &rhs) {
+        m_value = checkedMultDiv(m_value, rhs.m_value,
+                getPrecFactor());
         return *this;
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 typename std::enable_if<Prec >= Prec2, decimal>::type
     & operator*=(const decimal<Prec2>& rhs) {
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value, rhs.getUnbiased(),
-                DecimalFactor<Prec2>::value);
+        m_value = checkedMultDiv(m_value, rhs.getUnbiased(),
+                storage_traits<arithmetic_t>::pow10(Prec2));
         return *this;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    decimal & operator*=(const decimal<Prec2>& rhs) {
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value, rhs.getUnbiased(),
-                DecimalFactor<Prec2>::value);
+    DEC_CONSTEXPR14 decimal & operator*=(const decimal<Prec2>& rhs) {
+        m_value = checkedMultDiv(m_value, rhs.getUnbiased(),
+                storage_traits<arithmetic_t>::pow10(Prec2));
         return *this;
     }
 #endif
 
-    const decimal operator/(int rhs) const {
+    DEC_CONSTEXPR14 const decimal operator/(int rhs) const {
         decimal result = *this;
-
-        if (!RoundPolicy::div_rounded(result.m_value, this->m_value, rhs)) {
-            result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value, 1,
-                    rhs);
-        }
-
+        result.m_value = checkedDiv(m_value, rhs);
         return result;
     }
 
-    const decimal operator/(int64 rhs) const {
+    DEC_CONSTEXPR14 const decimal operator/(int64 rhs) const {
         decimal result = *this;
-
-        if (!RoundPolicy::div_rounded(result.m_value, this->m_value, rhs)) {
-            result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value, 1,
-                    rhs);
-        }
-
+        result.m_value = checkedDiv(m_value, rhs);
         return result;
     }
 
-    const decimal operator/(const decimal &rhs) const {
+    DEC_CONSTEXPR14 const decimal operator/(const decimal &rhs) const {
         decimal result = *this;
-        //result.m_value = (result.m_value * DecimalFactor<Prec>::value) / rhs.m_value;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                DecimalFactor<Prec>::value, rhs.m_value);
+        //result.m_value = (result.m_value * getPrecFactor()) / rhs.m_value;
+        result.m_value = checkedMultDiv(result.m_value,
+                getPrecFactor(), rhs.m_value);
 
         return result;
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    const typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 const typename std::enable_if<Prec >= Prec2, decimal>::type
     operator/(const decimal<Prec2>& rhs) const {
         decimal result = *this;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                DecimalFactor<Prec2>::value, rhs.getUnbiased());
+        result.m_value = checkedMultDiv(result.m_value,
+                storage_traits<arithmetic_t>::pow10(Prec2), rhs.getUnbiased());
         return result;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    const decimal operator/(const decimal<Prec2>& rhs) const {
+    DEC_CONSTEXPR14 const decimal operator/(const decimal<Prec2>& rhs) const {
         decimal result = *this;
-        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
-                DecimalFactor<Prec2>::value, rhs.getUnbiased());
+        result.m_value = checkedMultDiv(result.m_value,
+                storage_traits<arithmetic_t>::pow10(Prec2), rhs.getUnbiased());
         return result;
     }
 #endif
 
-    decimal & operator/=(int rhs) {
-        if (!RoundPolicy::div_rounded(this->m_value, this->m_value, rhs)) {
-            this->m_value = dec_utils<RoundPolicy>::multDiv(this->m_value, 1,
-                    rhs);
-        }
+    DEC_CONSTEXPR14 decimal & operator/=(int rhs) {
+        m_value = checkedDiv(m_value, rhs);
         return *this;
     }
 
-    decimal & operator/=(int64 rhs) {
-        if (!RoundPolicy::div_rounded(this->m_value, this->m_value, rhs)) {
-            this->m_value = dec_utils<RoundPolicy>::multDiv(this->m_value, 1,
-                    rhs);
-        }
+    DEC_CONSTEXPR14 decimal & operator/=(int64 rhs) {
+        m_value = checkedDiv(m_value, rhs);
         return *this;
     }
 
-    decimal & operator/=(const decimal &rhs) {
-        //m_value = (m_value * DecimalFactor<Prec>::value) / rhs.m_value;
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value,
-                DecimalFactor<Prec>::value, rhs.m_value);
+    DEC_CONSTEXPR14 decimal & operator/=(const decimal &rhs) {
+        //m_value = (m_value * getPrecFactor()) / rhs.m_value;
+        m_value = checkedMultDiv(m_value,
+                getPrecFactor(), rhs.m_value);
 
         return *this;
     }
@@ -1018,31 +2038,31 @@ template<int Prec2>
     /// -1 if value is < 0
     /// +1 if value is > 0
     /// 0  if value is 0
-    int sign() const {
+    DEC_CONSTEXPR int sign() const {
         return (m_value > 0) ? 1 : ((m_value < 0) ? -1 : 0);
     }
 
 #if DEC_TYPE_LEVEL == 1
     template<int Prec2>
-    typename std::enable_if<Prec >= Prec2, decimal>::type
+    DEC_CONSTEXPR14 typename std::enable_if<Prec >= Prec2, decimal>::type
     & operator/=(const decimal<Prec2> &rhs) {
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value,
-                DecimalFactor<Prec2>::value, rhs.getUnbiased());
+        m_value = checkedMultDiv(m_value,
+                storage_traits<arithmetic_t>::pow10(Prec2), rhs.getUnbiased());
 
         return *this;
     }
 #elif DEC_TYPE_LEVEL > 1
     template<int Prec2>
-    decimal & operator/=(const decimal<Prec2> &rhs) {
-        m_value = dec_utils<RoundPolicy>::multDiv(m_value,
-                DecimalFactor<Prec2>::value, rhs.getUnbiased());
+    DEC_CONSTEXPR14 decimal & operator/=(const decimal<Prec2> &rhs) {
+        m_value = checkedMultDiv(m_value,
+                storage_traits<arithmetic_t>::pow10(Prec2), rhs.getUnbiased());
 
         return *this;
     }
 #endif
 
     double getAsDouble() const {
-        return static_cast<double>(m_value) / getPrecFactorDouble();
+        return storage_utils_t::toDouble(m_value, getPrecFactor());
     }
 
     void setAsDouble(double value) {
@@ -1059,37 +2079,37 @@ template<int Prec2>
 
     // returns integer value = real_value * (10 ^ precision)
     // use to load/store decimal value in external memory
-    int64 getUnbiased() const {
+    DEC_CONSTEXPR raw_data_t getUnbiased() const {
         return m_value;
     }
-    void setUnbiased(int64 value) {
+    DEC_CONSTEXPR14 void setUnbiased(raw_data_t value) {
         m_value = value;
     }
 
-    decimal<Prec> abs() const {
+    DEC_CONSTEXPR14 decimal abs() const {
         if (m_value >= 0)
             return *this;
         else
-            return (decimal<Prec>(0) - *this);
+            return -*this;
     }
 
     /// returns value rounded to integer using active rounding policy
-    int64 getAsInteger() const {
-        int64 result;
-        RoundPolicy::div_rounded(result, m_value, DecimalFactor<Prec>::value);
+    DEC_CONSTEXPR14 raw_data_t getAsInteger() const {
+        raw_data_t result = 0;
+        storage_utils_t::template div_rounded_pow10<Prec>(result, m_value);
         return result;
     }
 
     /// overwrites internal value with integer
-    void setAsInteger(int64 value) {
-        m_value = DecimalFactor<Prec>::value * value;
+    DEC_CONSTEXPR14 void setAsInteger(int64 value) {
+        m_value = fromInteger(value);
     }
 
     /// Returns two parts: before and after decimal point
     /// For negative values both numbers are negative or zero.
-    void unpack(int64 &beforeValue, int64 &afterValue) const {
-        afterValue = m_value % DecimalFactor<Prec>::value;
-        beforeValue = (m_value - afterValue) / DecimalFactor<Prec>::value;
+    DEC_CONSTEXPR14 void unpack(raw_data_t &beforeValue, raw_data_t &afterValue) const {
+        afterValue = m_value % getPrecFactor();
+        beforeValue = (m_value - afterValue) / getPrecFactor();
     }
 
     /// Combines two parts (before and after decimal point) into decimal value.
@@ -1098,59 +2118,65 @@ template<int Prec2>
     /// \param[in] beforeValue value before decimal point
     /// \param[in] afterValue value after decimal point multiplied by 10^prec
     /// \result Returns *this
-    decimal &pack(int64 beforeValue, int64 afterValue) {
+    DEC_CONSTEXPR14 decimal &pack(raw_data_t beforeValue, raw_data_t afterValue) {
         if (Prec > 0) {
-            m_value = beforeValue * DecimalFactor<Prec>::value;
-            m_value += (afterValue % DecimalFactor<Prec>::value);
+            m_value = beforeValue * getPrecFactor();
+            m_value += (afterValue % getPrecFactor());
         } else
-            m_value = beforeValue * DecimalFactor<Prec>::value;
+            m_value = beforeValue * getPrecFactor();
         return *this;
     }
 
     /// Version of pack() with rounding, sourcePrec specifies precision of source values.
     /// See also @pack.
     template<int sourcePrec>
-    decimal &pack_rounded(int64 beforeValue, int64 afterValue) {
-        decimal<sourcePrec> temp;
+    decimal &pack_rounded(raw_data_t beforeValue, raw_data_t afterValue) {
+        decimal<sourcePrec, RoundPolicy, OverflowPolicy, arithmetic_t> temp;
         temp.pack(beforeValue, afterValue);
-        decimal<Prec> result(temp.getUnbiased(), temp.getPrecFactor());
-
-        *this = result;
+        if (sourcePrec > Prec) {
+            m_value = roundFromPrec<sourcePrec>(temp.getUnbiased());
+        } else {
+            m_value = static_cast<raw_data_t>(temp.getUnbiased()
+                    * storage_traits<arithmetic_t>::pow10(Prec - sourcePrec));
+        }
         return *this;
     }
 
-    static decimal buildWithExponent(int64 mantissa, int exponent) {
+    DEC_CONSTEXPR14 static decimal buildWithExponent(raw_data_t mantissa, int exponent) {
         decimal result;
         result.setWithExponent(mantissa, exponent);
         return result;
     }
 
-    static decimal &buildWithExponent(decimal &output, int64 mantissa,
+    static decimal &buildWithExponent(decimal &output, raw_data_t mantissa,
             int exponent) {
         output.setWithExponent(mantissa, exponent);
         return output;
     }
 
-    void setWithExponent(int64 mantissa, int exponent) {
+    DEC_CONSTEXPR14 void setWithExponent(raw_data_t mantissa, int exponent) {
 
         int exponentForPack = exponent + Prec;
 
         if (exponentForPack < 0) {
-            int64 newValue;
+            raw_data_t newValue;
 
-            if (!RoundPolicy::div_rounded(newValue, mantissa,
-                    dec_utils<RoundPolicy>::pow10(-exponentForPack))) {
+            if (!storage_utils_t::div_rounded(newValue, mantissa,
+                    storage_utils_t::pow10(-exponentForPack))) {
                 newValue = 0;
             }
 
             m_value = newValue;
+        } else if (OverflowPolicy::checked && (exponentForPack > storage_traits<raw_data_t>::max_decimal_points)
+                && (mantissa != 0)) {
+            m_value = OverflowPolicy::overflow(static_cast<raw_data_t>(0), mantissa > 0);
         } else {
-            m_value = mantissa * dec_utils<RoundPolicy>::pow10(exponentForPack);
+            m_value = checkedMul(mantissa, storage_utils_t::pow10(exponentForPack));
         }
     }
 
-    void getWithExponent(int64 &mantissa, int &exponent) const {
-        int64 value = m_value;
+    DEC_CONSTEXPR14 void getWithExponent(raw_data_t &mantissa, int &exponent) const {
+        raw_data_t value = m_value;
         int exp = -Prec;
 
         if (value != 0) {
@@ -1166,28 +2192,90 @@ template<int Prec2>
     }
 
 protected:
-    inline xdouble getPrecFactorXDouble() const {
-        return static_cast<xdouble>(DecimalFactor<Prec>::value);
-    }
-
-    inline double getPrecFactorDouble() const {
-        return static_cast<double>(DecimalFactor<Prec>::value);
-    }
+    typedef storage_utils<RoundPolicy, StorageType> storage_utils_t;
 
-    void init(const decimal &src) {
-        m_value = src.m_value;
-    }
+    // --> storage arithmetic, overflow is handled by OverflowPolicy
 
-    void init(uint value) {
-        m_value = DecimalFactor<Prec>::value * value;
+    static DEC_CONSTEXPR raw_data_t fromInteger(arithmetic_t value) {
+        return OverflowPolicy::checked ? checkedMul(getPrecFactor(), value)
+                : static_cast<raw_data_t>(getPrecFactor() * value);
     }
 
-    void init(int value) {
-        m_value = DecimalFactor<Prec>::value * value;
+    static DEC_CONSTEXPR14 raw_data_t checkedAdd(arithmetic_t value1, arithmetic_t value2) {
+        if (!OverflowPolicy::checked) {
+            return static_cast<raw_data_t>(value1 + value2);
+        }
+        raw_data_t result = 0;
+        if (storage_utils_t::addOverflow(value1, value2, result)) {
+            result = OverflowPolicy::overflow(result, value2 > 0);
+        }
+        return result;
     }
 
-    void init(int64 value) {
-        m_value = DecimalFactor<Prec>::value * value;
+    static DEC_CONSTEXPR14 raw_data_t checkedSub(arithmetic_t value1, arithmetic_t value2) {
+        if (!OverflowPolicy::checked) {
+            return static_cast<raw_data_t>(value1 - value2);
+        }
+        raw_data_t result = 0;
+        if (storage_utils_t::subOverflow(value1, value2, result)) {
+            result = OverflowPolicy::overflow(result, value2 < 0);
+        }
+        return result;
+    }
+
+    static DEC_CONSTEXPR14 raw_data_t checkedMul(arithmetic_t value1, arithmetic_t value2) {
+        if (!OverflowPolicy::checked) {
+            return static_cast<raw_data_t>(value1 * value2);
+        }
+        raw_data_t result = 0;
+        if (storage_utils_t::mulOverflow(value1, value2, result)) {
+            result = OverflowPolicy::overflow(result, (value1 < 0) == (value2 < 0));
+        }
+        return result;
+    }
+
+    static DEC_CONSTEXPR14 raw_data_t checkedMultDiv(arithmetic_t value1, arithmetic_t value2,
+            arithmetic_t divisor) {
+        if (!OverflowPolicy::checked) {
+            return storage_utils_t::multDiv(value1, value2, divisor);
+        }
+        raw_data_t result = 0;
+        if (storage_utils_t::multDivOverflow(value1, value2, divisor, result)) {
+            result = OverflowPolicy::overflow(result,
+                    ((value1 < 0) == (value2 < 0)) == (divisor > 0));
+        }
+        return result;
+    }
+
+    // value with Prec2 decimal points rounded to Prec decimal points (Prec2 > Prec)
+    template<int Prec2>
+    static DEC_CONSTEXPR14 raw_data_t roundFromPrec(arithmetic_t value) {
+        raw_data_t result = 0;
+        storage_utils_t::template div_rounded_pow10<(Prec2 > Prec) ? Prec2 - Prec : 0>(
+                result, value);
+        return result;
+    }
+
+    static DEC_CONSTEXPR14 raw_data_t checkedDiv(raw_data_t value, arithmetic_t divisor) {
+        if (OverflowPolicy::checked && (divisor == -1)
+                && (value == storage_traits<raw_data_t>::min_value())) {
+            return OverflowPolicy::overflow(value, true);
+        }
+        raw_data_t result = 0;
+        if (!storage_utils_t::div_rounded(result, value, divisor)) {
+            result = storage_utils_t::multDiv(value, 1, divisor);
+        }
+        return result;
+    }
+
+    // <--
+
+    inline xdouble getPrecFactorXDouble() const {
+        return static_cast<xdouble>(getPrecFactor());
+    }
+
+    inline double getPrecFactorDouble() const {
+        return static_cast<double>(getPrecFactor());
     }
 
     void init(xdouble value) {
@@ -1202,41 +2290,276 @@ protected:
         m_value = fpToStorage(static_cast<double>(value));
     }
 
-    void initWithPrec(int64 value, int64 precFactor) {
-        int64 ownFactor = DecimalFactor<Prec>::value;
+    DEC_CONSTEXPR14 void initWithPrec(arithmetic_t value, arithmetic_t precFactor) {
+        arithmetic_t ownFactor = getPrecFactor();
 
         if (ownFactor == precFactor) {
             // no conversion required
-            m_value = value;
+            m_value = static_cast<raw_data_t>(value);
         } else {
             // conversion
-            m_value = RoundPolicy::round(
-                    static_cast<cross_float>(value)
-                            * (static_cast<cross_float>(ownFactor)
-                                    / static_cast<cross_float>(precFactor)));
+            m_value = storage_utils_t::rescale(value, precFactor, ownFactor);
         }
     }
 
     template<typename T>
-    static dec_storage_t fpToStorage(T value) {
-        dec_storage_t intPart = dec_utils<RoundPolicy>::trunc(value);
-        T fracPart = value - intPart;
-        return RoundPolicy::round(
-                static_cast<T>(DecimalFactor<Prec>::value) * fracPart) +
-                  DecimalFactor<Prec>::value * intPart;
+    static raw_data_t fpToStorage(T value) {
+        if (!OverflowPolicy::checked) {
+            return storage_utils_t::fromFloat(value, getPrecFactor());
+        }
+        raw_data_t result = 0;
+        // NaN and infinity are reported as overflow too
+        if (storage_utils_t::fromFloatOverflow(value, getPrecFactor(), result)) {
+            result = OverflowPolicy::overflow(result, value > 0);
+        }
+        return result;
     }
 
     template<typename T>
-    static T abs(T value) {
+    DEC_CONSTEXPR14 static T abs(T value) {
         if (value < 0)
             return -value;
         else
             return value;
     }
 protected:
-    dec_storage_t m_value;
+    raw_data_t m_value;
+};
+
+/// Exact sum of decimal<Prec> values kept as 128-bit unbiased value.
+/// Addition is not checked for overflow (it needs at least 2^64 additions),
+/// range is checked only when sum is converted to decimal with getAsDecimal().
+///
+/// Sample usage:
+///   decimal_accumulator<6> total;
+///   for (size_t i = 0; i < amounts.size(); ++i)
+///       total += amounts[i];
+///   decimal<2> result;
+///   if (!total.getAsDecimal(result))
+///       handleOverflow();
+template<int Prec>
+class decimal_accumulator {
+public:
+    enum {
+        decimal_points = Prec
+    };
+
+    DEC_CONSTEXPR decimal_accumulator() :
+            m_low(0), m_high(0) {
+    }
+
+    template<class RoundPolicy, class OverflowPolicy>
+    DEC_CONSTEXPR explicit decimal_accumulator(
+            const decimal<Prec, RoundPolicy, OverflowPolicy> &value) :
+            m_low(static_cast<uint64>(value.getUnbiased())),
+            m_high((value.getUnbiased() < 0) ? ~static_cast<uint64>(0) : 0) {
+    }
+
+    template<class RoundPolicy, class OverflowPolicy>
+    DEC_CONSTEXPR14 decimal_accumulator &operator+=(
+            const decimal<Prec, RoundPolicy, OverflowPolicy> &rhs) {
+        addUnbiased(rhs.getUnbiased());
+        return *this;
+    }
+
+    template<class RoundPolicy, class OverflowPolicy>
+    DEC_CONSTEXPR14 decimal_accumulator &operator-=(
+            const decimal<Prec, RoundPolicy, OverflowPolicy> &rhs) {
+        const uint64 value = static_cast<uint64>(rhs.getUnbiased());
+        const uint64 low = m_low - value;
+        m_high -= ((rhs.getUnbiased() < 0) ? ~static_cast<uint64>(0) : 0) + ((low > m_low) ? 1 : 0);
+        m_low = low;
+        return *this;
+    }
+
+    DEC_CONSTEXPR14 decimal_accumulator &operator+=(const decimal_accumulator &rhs) {
+        const uint64 low = m_low + rhs.m_low;
+        m_high += rhs.m_high + ((low < m_low) ? 1 : 0);
+        m_low = low;
+        return *this;
+    }
+
+    DEC_CONSTEXPR14 decimal_accumulator &operator-=(const decimal_accumulator &rhs) {
+        const uint64 low = m_low - rhs.m_low;
+        m_high -= rhs.m_high + ((low > m_low) ? 1 : 0);
+        m_low = low;
+        return *this;
+    }
+
+    DEC_CONSTEXPR14 decimal_accumulator operator+(const decimal_accumulator &rhs) const {
+        decimal_accumulator result = *this;
+        result += rhs;
+        return result;
+    }
+
+    DEC_CONSTEXPR14 decimal_accumulator operator-(const decimal_accumulator &rhs) const {
+        decimal_accumulator result = *this;
+        result -= rhs;
+        return result;
+    }
+
+    DEC_CONSTEXPR bool operator==(const decimal_accumulator &rhs) const {
+        return (m_low == rhs.m_low) && (m_high == rhs.m_high);
+    }
+
+    DEC_CONSTEXPR bool operator!=(const decimal_accumulator &rhs) const {
+        return !(*this == rhs);
+    }
+
+    /// Adds unbiased value (see decimal::getUnbiased)
+    DEC_CONSTEXPR14 void addUnbiased(int64 value) {
+        const uint64 low = m_low + static_cast<uint64>(value);
+        m_high += ((value < 0) ? ~static_cast<uint64>(0) : 0) + ((low < m_low) ? 1 : 0);
+        m_low = low;
+    }
+
+    /// Returns -1 for negative, 0 for zero, +1 for positive sum
+    DEC_CONSTEXPR int sign() const {
+        return isNegative() ? -1 : (((m_low | m_high) != 0) ? 1 : 0);
+    }
+
+    /// Upper 64 bits of unbiased value, which is: high * 2^64 + low
+    DEC_CONSTEXPR int64 getUnbiasedHigh() const {
+        return static_cast<int64>(m_high);
+    }
+
+    /// Lower 64 bits of unbiased value
+    DEC_CONSTEXPR uint64 getUnbiasedLow() const {
+        return m_low;
+    }
+
+    /// Sets unbiased value to: high * 2^64 + low
+    DEC_CONSTEXPR14 void setUnbiased(int64 high, uint64 low) {
+        m_high = static_cast<uint64>(high);
+        m_low = low;
+    }
+
+    /// Converts sum to decimal, rounding it with RoundPolicy when Prec2 < Prec.
+    /// Returns false and leaves output unchanged when result does not fit.
+    template<int Prec2, class RoundPolicy, class OverflowPolicy>
+    DEC_CONSTEXPR14 bool getAsDecimal(decimal<Prec2, RoundPolicy, OverflowPolicy> &output) const {
+        const bool negative = isNegative();
+        uint64 high = m_high;
+        uint64 low = m_low;
+        if (negative) {
+            low = 0 - low;
+            high = ~high + ((low == 0) ? 1 : 0);
+        }
+
+        const uint64 limit = static_cast<uint64>(DEC_MAX_INT64) + (negative ? 1 : 0);
+        int64 result = 0;
+        if (Prec2 >= Prec) {
+            const uint64 factor = static_cast<uint64>(DecimalFactorDiff<Prec2 - Prec>::value);
+            if ((high != 0) || (low > limit / factor)) {
+                return false;
+            }
+            low *= factor;
+            result = static_cast<int64>(negative ? 0 - low : low);
+        } else {
+            const uint64 divisor = static_cast<uint64>(DecimalFactorDiff<Prec - Prec2>::value);
+            if (high >= divisor) {
+                return false;
+            }
+            uint64 remainder = 0;
+            const uint64 quotient = dec_utils<RoundPolicy>::udiv128(high, low, divisor, remainder);
+            if (!dec_utils<RoundPolicy>::roundQuotient(negative, quotient, remainder, divisor, result)) {
+                return false;
+            }
+        }
+
+        output.setUnbiased(result);
+        return true;
+    }
+
+private:
+    DEC_CONSTEXPR bool isNegative() const {
+        return (m_high >> 63) != 0;
+    }
+
+    uint64 m_low;
+    uint64 m_high;
+};
+
+/// Divides many decimal<Prec, RoundPolicy> values by the same runtime divisor
+/// (e.g. by a rate, share count or a total for percentages). Reciprocal of
+/// divisor is calculated once, then each division is done with multiplication
+/// (see invariant_divider) instead of hardware division. Without 128-bit
+/// integers regular division is used.
+/// Results are the same as of decimal's operator/, divisor must not be zero.
+///
+/// Sample usage:
+///   const decimal_divider<4> perShare(shareCount);
+///   for (size_t i = 0; i < profits.size(); ++i)
+///       profitPerShare[i] = profits[i] / perShare;
+template<int Prec, class RoundPolicy = def_round_policy>
+class decimal_divider {
+public:
+    typedef decimal<Prec, RoundPolicy> decimal_type;
+
+    /// Divider calculating value / divisor for decimal divisor
+    explicit decimal_divider(const decimal_type &divisor) :
+            m_multiplier(decimal_type::getPrecFactor()), m_divisor(divisor.getUnbiased())
+#ifdef DEC_HAS_INT128
+            , m_divider(initDivider(divisor.getUnbiased()))
+#endif
+    {
+    }
+
+    /// Divider calculating value / divisor for integer divisor, result is rounded
+    /// as for division by decimal equal to divisor
+    explicit decimal_divider(int64 divisor) :
+            m_multiplier(isScalable(divisor) ? decimal_type::getPrecFactor() : 1),
+            m_divisor(divisor * m_multiplier)
+#ifdef DEC_HAS_INT128
+            , m_divider(initDivider(m_divisor))
+#endif
+    {
+    }
+
+    decimal_type divide(const decimal_type &value) const {
+        decimal_type result;
+        result.setUnbiased(divideUnbiased(value.getUnbiased()));
+        return result;
+    }
+
+    /// Divides unbiased value (see decimal::getUnbiased)
+    int64 divideUnbiased(int64 value) const {
+#ifdef DEC_HAS_INT128
+        int64 result = 0;
+        if ((m_divisor != 0) && dec_utils<RoundPolicy>::multDiv128(value, m_multiplier,
+                m_divider, m_divisor < 0, result)) {
+            return result;
+        }
+#endif
+        // overflow (or no 128-bit integers) - handled as in decimal operators
+        return dec_utils<RoundPolicy>::multDiv(value, m_multiplier, m_divisor);
+    }
+
+private:
+    static bool isScalable(int64 divisor) {
+        return dec_utils<RoundPolicy>::uabs(divisor)
+                <= static_cast<uint64>(DEC_MAX_INT64 / decimal_type::getPrecFactor());
+    }
+
+#ifdef DEC_HAS_INT128
+    static invariant_divider initDivider(int64 divisor) {
+        return invariant_divider((divisor != 0) ? dec_utils<RoundPolicy>::uabs(divisor) : 1);
+    }
+#endif
+
+    int64 m_multiplier;
+    int64 m_divisor;
+#ifdef DEC_HAS_INT128
+    invariant_divider m_divider;
+#endif
 };
 
+template<int Prec, class RoundPolicy>
+decimal<Prec, RoundPolicy> operator/(const decimal<Prec, RoundPolicy> &value,
+        const decimal_divider<Prec, RoundPolicy> &divider) {
+    return divider.divide(value);
+}
+
 // ----------------------------------------------------------------------------
 // Pre-defined types
 // ----------------------------------------------------------------------------
@@ -1244,9 +2567,51 @@ typedef decimal<2> decimal2;
 typedef decimal<4> decimal4;
 typedef decimal<6> decimal6;
 
+#ifndef DEC_NO_CPP11
+/// Decimal with 32-bit storage: up to 9 digits, precision up to 9,
+/// arithmetic is done with 64-bit integers
+template<int Prec, class RoundPolicy = def_round_policy,
+        class OverflowPolicy = unchecked_overflow_policy>
+using decimal32 = decimal<Prec, RoundPolicy, OverflowPolicy, int32>;
+#endif
+
+#if defined(DEC_HAS_INT128) && !defined(DEC_NO_CPP11)
+/// Decimal with 128-bit storage: up to 38 digits, precision up to 38
+template<int Prec, class RoundPolicy = def_round_policy,
+        class OverflowPolicy = unchecked_overflow_policy>
+using decimal128 = decimal<Prec, RoundPolicy, OverflowPolicy, int128>;
+#endif
+
+#ifndef DEC_NO_CPP11
+// decimal can be copied with memcpy and stored in shared / mapped memory
+static_assert(std::is_trivially_copyable<decimal2>::value, "decimal has to be trivially copyable");
+static_assert(std::is_standard_layout<decimal2>::value, "decimal has to be standard-layout");
+static_assert(sizeof(decimal2) == sizeof(dec_storage_t), "decimal has to be the same size as its storage");
+static_assert(sizeof(decimal32<2>) == sizeof(int32), "decimal has to be the same size as its storage");
+#ifdef DEC_HAS_INT128
+static_assert(std::is_trivially_copyable<decimal128<8> >::value, "decimal has to be trivially copyable");
+static_assert(sizeof(decimal128<8>) == sizeof(int128), "decimal has to be the same size as its storage");
+#endif
+#endif
+
 // ----------------------------------------------------------------------------
 // global functions
 // ----------------------------------------------------------------------------
+namespace details {
+
+/// Converts string to decimal using from_chars, leading spaces and tabs are ignored.
+/// Output is set to 0 on error.
+template<int prec, typename roundPolicy, typename overflowPolicy, typename storageType>
+DEC_CONSTEXPR14 void parse_string(const char *first, const char *last,
+        decimal<prec, roundPolicy, overflowPolicy, storageType> &out) {
+    while ((first != last) && ((*first == ' ') || (*first == '\t')))
+        ++first;
+    if (from_chars(first, last, out).ec != std::errc())
+        out.setUnbiased(0);
+}
+
+} // namespace details
+
 template<int Prec, class T>
 decimal<Prec> decimal_cast(const T &arg) {
     return decimal<Prec>(arg.getUnbiased(), arg.getPrecFactor());
@@ -1255,19 +2620,19 @@ decimal<Prec> decimal_cast(const T &arg) {
 // Example of use:
 //   c = dec::decimal_cast<6>(a * b);
 template<int Prec>
-decimal<Prec> decimal_cast(uint arg) {
+DEC_CONSTEXPR14 decimal<Prec> decimal_cast(uint arg) {
     decimal<Prec> result(arg);
     return result;
 }
 
 template<int Prec>
-decimal<Prec> decimal_cast(int arg) {
+DEC_CONSTEXPR14 decimal<Prec> decimal_cast(int arg) {
     decimal<Prec> result(arg);
     return result;
 }
 
 template<int Prec>
-decimal<Prec> decimal_cast(int64 arg) {
+DEC_CONSTEXPR14 decimal<Prec> decimal_cast(int64 arg) {
     decimal<Prec> result(arg);
     return result;
 }
@@ -1285,26 +2650,27 @@ decimal<Prec> decimal_cast(const std::string &arg) {
 }
 
 template<int Prec, int N>
-decimal<Prec> decimal_cast(const char (&arg)[N]) {
-    decimal<Prec> result(arg);
+DEC_CONSTEXPR14 decimal<Prec> decimal_cast(const char (&arg)[N]) {
+    decimal<Prec> result;
+    details::parse_string(arg, arg + N - 1, result);
     return result;
 }
 
 // with rounding policy
 template<int Prec, typename RoundPolicy>
-decimal<Prec, RoundPolicy> decimal_cast(uint arg) {
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy> decimal_cast(uint arg) {
     decimal<Prec, RoundPolicy> result(arg);
     return result;
 }
 
 template<int Prec, typename RoundPolicy>
-decimal<Prec, RoundPolicy> decimal_cast(int arg) {
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy> decimal_cast(int arg) {
     decimal<Prec, RoundPolicy> result(arg);
     return result;
 }
 
 template<int Prec, typename RoundPolicy>
-decimal<Prec, RoundPolicy> decimal_cast(int64 arg) {
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy> decimal_cast(int64 arg) {
     decimal<Prec, RoundPolicy> result(arg);
     return result;
 }
@@ -1322,11 +2688,259 @@ decimal<Prec, RoundPolicy> decimal_cast(const std::string &arg) {
 }
 
 template<int Prec, typename RoundPolicy, int N>
-decimal<Prec, RoundPolicy> decimal_cast(const char (&arg)[N]) {
-    decimal<Prec, RoundPolicy> result(arg);
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy> decimal_cast(const char (&arg)[N]) {
+    decimal<Prec, RoundPolicy> result;
+    details::parse_string(arg, arg + N - 1, result);
     return result;
 }
 
+// with output type, e.g.:
+//   decimal32<2> price = dec::decimal_cast<decimal32<2> >(amount);
+
+/// Converts decimal to DecimalType, which can have different precision and storage.
+/// Value is rounded using rounding policy of DecimalType, if it does not fit
+/// in storage of DecimalType then overflow policy of DecimalType is used.
+template<class DecimalType, int Prec, class RoundPolicy, class OverflowPolicy,
+        class StorageType>
+DEC_CONSTEXPR14 DecimalType decimal_cast(
+        const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &arg) {
+    typedef typename DecimalType::raw_data_t output_type;
+    typedef typename DecimalType::overflow_policy_t output_overflow_policy;
+    // calculation is done with arithmetic type of wider storage
+    typedef typename std::conditional<(sizeof(StorageType) >= sizeof(output_type)),
+            typename storage_traits<StorageType>::arithmetic_type,
+            typename DecimalType::arithmetic_t>::type wide_type;
+    typedef storage_utils<typename DecimalType::round_policy_t, wide_type> utils;
+
+    wide_type value = arg.getUnbiased();
+    bool overflow = false;
+    if (Prec > DecimalType::decimal_points) {
+        utils::template div_rounded_pow10<(Prec > DecimalType::decimal_points)
+                ? Prec - DecimalType::decimal_points : 0>(value, value);
+    } else if (Prec < DecimalType::decimal_points) {
+        overflow = utils::mulOverflow(value, storage_traits<wide_type>::pow10(
+                DecimalType::decimal_points - Prec), value);
+    }
+
+    output_type result = static_cast<output_type>(value);
+    if (output_overflow_policy::checked
+            && (overflow || (static_cast<wide_type>(result) != value))) {
+        result = output_overflow_policy::overflow(result, arg.getUnbiased() > 0);
+    }
+
+    DecimalType output;
+    output.setUnbiased(result);
+    return output;
+}
+
+/// Converts integer, floating point value or string to DecimalType
+template<class DecimalType, class T>
+DecimalType decimal_cast(const T &arg) {
+    return DecimalType(arg);
+}
+
+/// Converts decimal to decimal<Prec>, rounding with its default policy
+template<int Prec, int Prec2, class RoundPolicy, class OverflowPolicy, class StorageType>
+DEC_CONSTEXPR14 decimal<Prec> decimal_cast(
+        const decimal<Prec2, RoundPolicy, OverflowPolicy, StorageType> &arg) {
+    return decimal_cast<decimal<Prec> >(arg);
+}
+
+/// Exact product of decimals: result has precision Prec1 + Prec2 and is calculated
+/// with one integer multiplication, without rounding and division.
+/// Result type uses policies and storage of the first argument, precision out of
+/// storage range is rejected at compile time, value overflow is handled by overflow policy.
+/// Sample usage:
+///   decimal2 amount = decimal_cast<2>(exact_mult(exact_mult(price, rate), quantity));
+template<int Prec1, class RoundPolicy, class OverflowPolicy, class StorageType,
+        int Prec2, class RoundPolicy2, class OverflowPolicy2, class StorageType2>
+DEC_CONSTEXPR14 decimal<Prec1 + Prec2, RoundPolicy, OverflowPolicy, StorageType> exact_mult(
+        const decimal<Prec1, RoundPolicy, OverflowPolicy, StorageType> &lhs,
+        const decimal<Prec2, RoundPolicy2, OverflowPolicy2, StorageType2> &rhs) {
+    typedef decimal<Prec1 + Prec2, RoundPolicy, OverflowPolicy, StorageType> result_type;
+    typedef typename result_type::arithmetic_t arithmetic_type;
+    typedef typename result_type::raw_data_t raw_data_type;
+    static_assert(sizeof(StorageType2) <= sizeof(arithmetic_type),
+            "Storage of second argument is too wide");
+
+    const arithmetic_type value1 = lhs.getUnbiased();
+    const arithmetic_type value2 = rhs.getUnbiased();
+    raw_data_type value = 0;
+    if (!OverflowPolicy::checked) {
+        value = static_cast<raw_data_type>(value1 * value2);
+    } else if (storage_utils<RoundPolicy, StorageType>::mulOverflow(value1, value2, value)) {
+        value = OverflowPolicy::overflow(value, (value1 < 0) == (value2 < 0));
+    }
+
+    result_type result;
+    result.setUnbiased(value);
+    return result;
+}
+
+namespace details {
+
+// Type used for exact intermediate values calculated from T operands
+template<class T>
+struct wide_arithmetic {
+    typedef T type;
+};
+
+#ifdef DEC_HAS_INT128
+template<>
+struct wide_arithmetic<int64> {
+    typedef int128 type;
+};
+#endif
+
+} // namespace details
+
+/// Calculates a * b / c rounded once using rounding policy of a, instead of
+/// rounding after each operator. Product a * b is not rounded (128-bit or
+/// wider intermediate value). Result has type of a, overflow is handled by
+/// its overflow policy. Division by zero is not checked (as in operator/).
+/// Sample usage:
+///   decimal2 interest = muldiv(balance, rate, decimal_cast<0>(365));
+template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType,
+        int Prec2, class RoundPolicy2, class OverflowPolicy2, class StorageType2,
+        int Prec3, class RoundPolicy3, class OverflowPolicy3, class StorageType3>
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> muldiv(
+        const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &a,
+        const decimal<Prec2, RoundPolicy2, OverflowPolicy2, StorageType2> &b,
+        const decimal<Prec3, RoundPolicy3, OverflowPolicy3, StorageType3> &c) {
+    typedef decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> result_type;
+    typedef typename result_type::arithmetic_t arithmetic_type;
+    typedef typename result_type::raw_data_t raw_data_type;
+    typedef typename details::wide_arithmetic<arithmetic_type>::type wide_type;
+    typedef storage_utils<RoundPolicy, StorageType> utils;
+    typedef storage_utils<RoundPolicy, wide_type> wide_utils;
+    static_assert((sizeof(StorageType2) <= sizeof(arithmetic_type))
+            && (sizeof(StorageType3) <= sizeof(arithmetic_type)),
+            "Storage of argument is too wide");
+
+    // a * b / c = a.raw * (b.raw * 10^Prec3) / (c.raw * 10^Prec2)
+    const arithmetic_type value1 = a.getUnbiased();
+    wide_type value2 = b.getUnbiased();
+    wide_type divisor = c.getUnbiased();
+    const bool positive = ((value1 < 0) == (value2 < 0)) == (divisor > 0);
+    bool scaleOverflow = false;
+    if (Prec3 > Prec2) {
+        scaleOverflow = wide_utils::mulOverflow(value2,
+                storage_traits<wide_type>::pow10(Prec3 - Prec2), value2);
+    } else if (Prec2 > Prec3) {
+        scaleOverflow = wide_utils::mulOverflow(divisor,
+                storage_traits<wide_type>::pow10(Prec2 - Prec3), divisor);
+    }
+
+    raw_data_type result = 0;
+    bool overflow = false;
+    if (scaleOverflow) {
+        // possible only without wider type - rounded twice, as a * b / c
+        overflow = utils::multDivOverflow(value1, b.getUnbiased(),
+                storage_traits<arithmetic_type>::pow10(Prec2), result);
+        overflow = utils::multDivOverflow(result, storage_traits<arithmetic_type>::pow10(Prec3),
+                c.getUnbiased(), result) || overflow;
+    } else if ((static_cast<arithmetic_type>(value2) == value2)
+            && (static_cast<arithmetic_type>(divisor) == divisor)) {
+        overflow = utils::multDivOverflow(value1, static_cast<arithmetic_type>(value2),
+                static_cast<arithmetic_type>(divisor), result);
+    } else {
+        wide_type wideResult = 0;
+        overflow = wide_utils::multDivOverflow(value1, value2, divisor, wideResult);
+        result = static_cast<raw_data_type>(wideResult);
+        overflow = overflow || (static_cast<wide_type>(result) != wideResult);
+    }
+
+    if (OverflowPolicy::checked && overflow) {
+        result = OverflowPolicy::overflow(result, positive);
+    }
+
+    result_type output;
+    output.setUnbiased(result);
+    return output;
+}
+
+#ifdef DEC_HAS_INT128
+/// Calculates a * b + c rounded once using rounding policy of c, with exact
+/// 128-bit intermediate values. Result has type of c, overflow is handled by
+/// its overflow policy. Storage of arguments can have at most 64 bits,
+/// precision of a * b can exceed precision of c by at most 19 digits.
+/// Sample usage:
+///   total = fma(price, quantity, total);
+template<int Prec1, class RoundPolicy1, class OverflowPolicy1, class StorageType1,
+        int Prec2, class RoundPolicy2, class OverflowPolicy2, class StorageType2,
+        int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+DEC_CONSTEXPR14 decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> fma(
+        const decimal<Prec1, RoundPolicy1, OverflowPolicy1, StorageType1> &a,
+        const decimal<Prec2, RoundPolicy2, OverflowPolicy2, StorageType2> &b,
+        const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &c) {
+    typedef decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> result_type;
+    typedef typename result_type::raw_data_t raw_data_type;
+    typedef storage_utils<RoundPolicy, int128> wide_utils;
+    enum {
+        product_prec = Prec1 + Prec2
+    };
+    static_assert((sizeof(StorageType1) <= sizeof(int64)) && (sizeof(StorageType2) <= sizeof(int64))
+            && (sizeof(StorageType) <= sizeof(int64)), "Storage of argument is too wide");
+    static_assert(product_prec - Prec <= 19, "Precision of product is too high");
+
+    // both values are scaled to higher precision, so they fit in 128 bits
+    // unless result does not fit in 64 bits
+    int128 product = static_cast<int128>(a.getUnbiased()) * b.getUnbiased();
+    int128 addend = c.getUnbiased();
+    const bool positive = (product != 0) ? (product > 0) : (addend > 0);
+    bool overflow = false;
+    if (product_prec > Prec) {
+        addend *= storage_traits<int128>::pow10(product_prec - Prec);
+    } else if (Prec > product_prec) {
+        overflow = wide_utils::mulOverflow(product,
+                storage_traits<int128>::pow10(Prec - product_prec), product);
+    }
+
+    int128 sum = 0;
+    overflow = wide_utils::addOverflow(product, addend, sum) || overflow;
+    if (product_prec > Prec) {
+        wide_utils::template div_rounded_pow10<(product_prec > Prec) ? product_prec - Prec : 0>(
+                sum, sum);
+    }
+
+    raw_data_type result = static_cast<raw_data_type>(sum);
+    if (OverflowPolicy::checked && (overflow || (static_cast<int128>(result) != sum))) {
+        result = OverflowPolicy::overflow(result, overflow ? positive : (sum > 0));
+    }
+
+    result_type output;
+    output.setUnbiased(result);
+    return output;
+}
+#endif // DEC_HAS_INT128
+
+namespace details {
+
+template<typename StreamType, typename T>
+void write_integer(StreamType &output, T value) {
+    output << value;
+}
+
+#ifdef DEC_HAS_INT128
+// streams do not support int128, so it is written as string (width is applied)
+template<typename StreamType>
+void write_integer(StreamType &output, int128 value) {
+    char buffer[40];
+    char *pos = buffer + sizeof(buffer);
+    uint128 absValue = storage_utils<def_round_policy, int128>::uabs(value);
+    do {
+        *--pos = static_cast<char>('0' + static_cast<int>(absValue % 10));
+        absValue /= 10;
+    } while (absValue != 0);
+    if (value < 0) {
+        *--pos = '-';
+    }
+    output << std::string(pos, buffer + sizeof(buffer));
+}
+#endif
+
+} // namespace details
+
 /// Exports decimal to stream
 /// Used format: {-}bbbb.aaaa where
 /// {-} is optional '-' sign character
@@ -1337,7 +2951,7 @@ template<class decimal_type, typename StreamType>
 void toStream(const decimal_type &arg, StreamType &output) {
     using namespace std;
 
-    int64 before, after;
+    typename decimal_type::raw_data_t before, after;
     int sign;
 
     arg.unpack(before, after);
@@ -1358,51 +2972,335 @@ void toStream(const decimal_type &arg, StreamType &output) {
 
     const char dec_point =
             use_facet<numpunct<char> >(output.getloc()).decimal_point();
-    output << before;
+    details::write_integer(output, before);
     if (arg.getDecimalPoints() > 0) {
         output << dec_point;
-        output << setw(arg.getDecimalPoints()) << setfill('0') << right
-                << after;
+        output << setw(arg.getDecimalPoints()) << setfill('0') << right;
+        details::write_integer(output, after);
     }
 }
 
+/// Result of to_chars(), the same meaning as std::to_chars_result:
+/// ptr is one-past-the-end of written chars, ec is std::errc() on success
+/// or std::errc::value_too_large (with ptr == last) if output is too small.
+struct to_chars_result {
+    char *ptr;
+    std::errc ec;
+};
+
 namespace details {
 
-/// Extract values from stream ready to be packed to decimal
-template<typename StreamType>
-bool parse_unpacked(StreamType &input, int &sign, int64 &before, int64 &after,
-        int &decimalDigits) {
-    using namespace std;
+inline const char *digit_pairs() {
+    static const char table[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+    return table;
+}
 
-    enum StateEnum {
-        IN_SIGN, IN_BEFORE_FIRST_DIG, IN_BEFORE_DEC, IN_AFTER_DEC, IN_END
-    } state = IN_SIGN;
-    const numpunct<char> *facet =
-            has_facet<numpunct<char> >(input.getloc()) ?
-                    &use_facet<numpunct<char> >(input.getloc()) : NULL;
-    const char dec_point = (facet != NULL) ? facet->decimal_point() : '.';
-    const bool thousands_grouping =
-            (facet != NULL) ? (!facet->grouping().empty()) : false;
-    const char thousands_sep = (facet != NULL) ? facet->thousands_sep() : ',';
-    enum ErrorCodes {
-        ERR_WRONG_CHAR = -1,
-        ERR_NO_DIGITS = -2,
-        ERR_WRONG_STATE = -3,
-        ERR_STREAM_GET_ERROR = -4
-    };
+inline int count_digits(uint64 value) {
+    int result = 1;
+    while (value >= 100) {
+        value /= 100;
+        result += 2;
+    }
+    return (value >= 10) ? result + 1 : result;
+}
 
-    before = after = 0;
-    sign = 1;
+inline int count_digits(uint32 value) {
+    return count_digits(static_cast<uint64>(value));
+}
+
+#ifdef DEC_HAS_INT128
+inline int count_digits(uint128 value) {
+    int result = 0;
+    while ((value >> 64) != 0) {
+        value /= 1000000000000000000ULL;
+        result += 18;
+    }
+    return result + count_digits(static_cast<uint64>(value));
+}
+#endif
 
-    int error = 0;
-    int digitsCount = 0;
-    int afterDigitCount = 0;
-    char c;
+/// Writes exactly digitCount digits of value (padded with zeros) ending at end.
+/// \result Returns position of the first written char
+inline char *write_digits_backward(char *end, uint64 value, int digitCount) {
+    const char *pairs = digit_pairs();
+    while (digitCount >= 2) {
+        const unsigned pos = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        end[0] = pairs[pos];
+        end[1] = pairs[pos + 1];
+        digitCount -= 2;
+    }
+    if (digitCount > 0) {
+        *--end = static_cast<char>('0' + value % 10);
+    }
+    return end;
+}
 
-    while ((input) && (state != IN_END)) // loop while extraction from file is possible
-    {
-        c = static_cast<char>(input.get());
+inline char *write_digits_backward(char *end, uint32 value, int digitCount) {
+    return write_digits_backward(end, static_cast<uint64>(value), digitCount);
+}
+
+#ifdef DEC_HAS_INT128
+inline char *write_digits_backward(char *end, uint128 value, int digitCount) {
+    // 18 digits at once using 64-bit arithmetic
+    while (digitCount > 18) {
+        end = write_digits_backward(end,
+                static_cast<uint64>(value % 1000000000000000000ULL), 18);
+        value /= 1000000000000000000ULL;
+        digitCount -= 18;
+    }
+    return write_digits_backward(end, static_cast<uint64>(value), digitCount);
+}
+#endif
+
+} // namespace details
+
+/// Writes decimal to character buffer [first, last) without locale lookup
+/// and without memory allocation. Output is not null-terminated.
+/// Used format: {-}bbbb.aaaa where
+/// {-} is optional '-' sign character
+/// '.' is always used as decimal point
+/// bbbb is stream of digits before decimal point
+/// aaaa is stream of digits after decimal point (exactly Prec digits)
+template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+to_chars_result to_chars(char *first, char *last,
+        const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &arg) {
+    typedef typename storage_traits<StorageType>::unsigned_type unsigned_type;
+    const StorageType value = arg.getUnbiased();
+    const unsigned_type absValue = storage_utils<RoundPolicy, StorageType>::uabs(value);
+    const unsigned_type factor = static_cast<unsigned_type>(arg.getPrecFactor());
+    const unsigned_type before = absValue / factor;
+    const unsigned_type after = absValue % factor;
+
+    const int beforeDigits = details::count_digits(before);
+    const int length = ((value < 0) ? 1 : 0) + beforeDigits
+            + ((Prec > 0) ? Prec + 1 : 0);
+
+    to_chars_result result;
+    if (last - first < length) {
+        result.ptr = last;
+        result.ec = std::errc::value_too_large;
+        return result;
+    }
+
+    char *pos = first + length;
+    if (Prec > 0) {
+        pos = details::write_digits_backward(pos, after, Prec);
+        *--pos = '.';
+    }
+    pos = details::write_digits_backward(pos, before, beforeDigits);
+    if (value < 0) {
+        *--pos = '-';
+    }
+
+    result.ptr = first + length;
+    result.ec = std::errc();
+    return result;
+}
+
+/// Result of from_chars(), the same meaning as std::from_chars_result:
+/// ptr is the first char not matching the pattern, ec is std::errc() on success,
+/// std::errc::invalid_argument (with ptr == first) if no digits were found
+/// or std::errc::result_out_of_range if value does not fit in decimal.
+struct from_chars_result {
+    const char *ptr;
+    std::errc ec;
+};
+
+namespace details {
+
+inline DEC_CONSTEXPR bool is_digit(char c) {
+    return (c >= '0') && (c <= '9');
+}
+
+#ifdef DEC_USE_SWAR
+inline uint64 load_eight_chars(const char *pos) {
+    uint64 result;
+    std::memcpy(&result, pos, sizeof(result));
+    return result;
+}
+
+inline bool is_eight_digits(uint64 chars) {
+    return ((chars & 0xF0F0F0F0F0F0F0F0ULL)
+            | (((chars + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+            == 0x3333333333333333ULL;
+}
+
+// converts 8 ASCII digits to number using SWAR (first char is the most significant digit)
+inline uint64 parse_eight_digits(uint64 chars) {
+    chars = ((chars & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    chars = ((chars & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return ((chars & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+}
+#endif // DEC_USE_SWAR
 
+/// Reads at most limit digits starting at first, appends them to value.
+/// \result Returns position of the first char not consumed
+template<class T>
+inline DEC_CONSTEXPR14 const char *scan_digits(const char *first, const char *last,
+        int limit, T &value, int &count) {
+    count = 0;
+#ifdef DEC_USE_SWAR
+    if (!DEC_IS_CONSTANT_EVALUATED()) {
+        while ((limit - count >= 8) && (last - first >= 8)) {
+            const uint64 chars = load_eight_chars(first);
+            if (!is_eight_digits(chars))
+                break;
+            value = value * 100000000 + parse_eight_digits(chars);
+            first += 8;
+            count += 8;
+        }
+    }
+#endif
+    while ((count < limit) && (first != last) && is_digit(*first)) {
+        value = value * 10 + static_cast<T>(*first - '0');
+        ++first;
+        ++count;
+    }
+    return first;
+}
+
+/// Skips digits, sets nonZero if any of them is not '0'
+inline DEC_CONSTEXPR14 const char *skip_digits(const char *first, const char *last, bool &nonZero) {
+    while ((first != last) && is_digit(*first)) {
+        if (*first != '0')
+            nonZero = true;
+        ++first;
+    }
+    return first;
+}
+
+} // namespace details
+
+/// Converts chars from [first, last) to decimal without locale lookup
+/// and without memory allocation.
+/// Handles the following formats: {+|-}bbbb{.aaaa}, {+|-}.aaaa where
+/// '.' is always used as decimal point. Leading spaces are not accepted.
+/// Performs exact rounding with output's rounding policy when provided
+/// value has more fractional digits than output type.
+/// On error output is not modified.
+template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+DEC_CONSTEXPR14 from_chars_result from_chars(const char *first, const char *last,
+        decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &output) {
+    typedef storage_traits<StorageType> traits;
+    typedef typename traits::unsigned_type unsigned_type;
+    // wide enough for storage and for 18 digits used for rounding
+    typedef typename storage_traits<typename traits::arithmetic_type>::unsigned_type round_type;
+    from_chars_result result = { first, std::errc() };
+    const char *pos = first;
+    bool negative = false;
+
+    if ((pos != last) && ((*pos == '-') || (*pos == '+'))) {
+        negative = (*pos == '-');
+        ++pos;
+    }
+
+    // integer part
+    const char *intStart = pos;
+    while ((pos != last) && (*pos == '0'))
+        ++pos;
+
+    unsigned_type before = 0;
+    int beforeDigits = 0;
+    bool overflow = false;
+    pos = details::scan_digits(pos, last, traits::digits10, before, beforeDigits);
+    if ((pos != last) && details::is_digit(*pos)) {
+        // one more digit fits if value does not wrap around
+        const unsigned_type digit = static_cast<unsigned_type>(*pos - '0');
+        if ((beforeDigits == traits::digits10)
+                && (before <= (~static_cast<unsigned_type>(0) - digit) / 10)) {
+            before = before * 10 + digit;
+            ++pos;
+        }
+        if ((pos != last) && details::is_digit(*pos)) {
+            overflow = true;
+            pos = details::skip_digits(pos, last, overflow);
+        }
+    }
+    bool hasDigits = (pos != intStart);
+
+    // fractional part: Prec digits, then up to 18 digits used for rounding
+    unsigned_type after = 0;
+    uint64 excess = 0;
+    uint64 excessFactor = 1;
+    if ((pos != last) && (*pos == '.')) {
+        const char *fracStart = ++pos;
+        int afterDigits = 0;
+        int excessDigits = 0;
+        pos = details::scan_digits(pos, last, Prec, after, afterDigits);
+        after *= static_cast<unsigned_type>(traits::pow10(Prec - afterDigits));
+        pos = details::scan_digits(pos, last, max_decimal_points, excess, excessDigits);
+        excessFactor = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(excessDigits));
+        bool sticky = false;
+        pos = details::skip_digits(pos, last, sticky);
+        if (sticky) {
+            // keep information that remainder is above the stored digits
+            excess = excess * 10 + 1;
+            excessFactor *= 10;
+        }
+        hasDigits = hasDigits || (pos != fracStart);
+    }
+
+    if (!hasDigits) {
+        result.ptr = first;
+        result.ec = std::errc::invalid_argument;
+        return result;
+    }
+
+    result.ptr = pos;
+
+    const unsigned_type factor = static_cast<unsigned_type>(output.getPrecFactor());
+    const unsigned_type maxValue = static_cast<unsigned_type>(traits::max_value())
+            + (negative ? 1 : 0);
+    if (overflow || (before > (maxValue - after) / factor)) {
+        result.ec = std::errc::result_out_of_range;
+        return result;
+    }
+
+    unsigned_type value = before * factor + after;
+    if (RoundPolicy::away_from_zero(negative, static_cast<round_type>(value),
+            static_cast<round_type>(excess), static_cast<round_type>(excessFactor))) {
+        if (value == maxValue) {
+            result.ec = std::errc::result_out_of_range;
+            return result;
+        }
+        ++value;
+    }
+
+    output.setUnbiased(static_cast<StorageType>(negative ? 0 - value : value));
+    result.ec = std::errc();
+    return result;
+}
+
+namespace details {
+
+/// State machine of parse_unpacked, characters are consumed one by one.
+/// Values are extracted ready to be packed to decimal.
+template<typename T>
+class unpacked_parser {
+public:
+    unpacked_parser(char decPoint, bool thousandsGrouping, char thousandsSep) :
+            dec_point(decPoint), thousands_grouping(thousandsGrouping),
+            thousands_sep(thousandsSep), state(IN_SIGN), error(0), sign(1),
+            digitsCount(0), afterDigitCount(0), before(0), after(0) {
+    }
+
+    bool done() const {
+        return state == IN_END;
+    }
+
+    void put(char c) {
         switch (state) {
         case IN_SIGN:
             if (c == '-') {
@@ -1450,7 +3348,7 @@ bool parse_unpacked(StreamType &input, int &sign, int64 &before, int64 &after,
             if ((c >= '0') && (c <= '9')) {
                 after = 10 * after + static_cast<int>(c - '0');
                 afterDigitCount++;
-                if (afterDigitCount >= DEC_NAMESPACE::max_decimal_points)
+                if (afterDigitCount >= storage_traits<T>::max_decimal_points)
                     state = IN_END;
             } else {
                 state = IN_END;
@@ -1464,24 +3362,108 @@ bool parse_unpacked(StreamType &input, int &sign, int64 &before, int64 &after,
             state = IN_END;
             break;
         } // switch state
-    } // while stream good & not end
-
-    decimalDigits = afterDigitCount;
+    }
 
-    if (error >= 0) {
+    bool result(int &outSign, T &outBefore, T &outAfter, int &decimalDigits) const {
+        decimalDigits = afterDigitCount;
+        outSign = sign;
 
-        if (sign < 0) {
-            before = -before;
-            after = -after;
+        if (error >= 0) {
+            outBefore = (sign < 0) ? -before : before;
+            outAfter = (sign < 0) ? -after : after;
+        } else {
+            outBefore = outAfter = 0;
         }
 
-    } else {
-        before = after = 0;
+        return (error >= 0);
+    }
+
+private:
+    enum StateEnum {
+        IN_SIGN, IN_BEFORE_FIRST_DIG, IN_BEFORE_DEC, IN_AFTER_DEC, IN_END
+    };
+    enum ErrorCodes {
+        ERR_WRONG_CHAR = -1,
+        ERR_NO_DIGITS = -2,
+        ERR_WRONG_STATE = -3,
+        ERR_STREAM_GET_ERROR = -4
+    };
+
+    const char dec_point;
+    const bool thousands_grouping;
+    const char thousands_sep;
+    StateEnum state;
+    int error;
+    int sign;
+    int digitsCount;
+    int afterDigitCount;
+    T before;
+    T after;
+};
+
+/// Extract values from stream ready to be packed to decimal
+template<typename StreamType, typename T>
+bool parse_unpacked(StreamType &input, int &sign, T &before, T &after,
+        int &decimalDigits) {
+    using namespace std;
+
+    const numpunct<char> *facet =
+            has_facet<numpunct<char> >(input.getloc()) ?
+                    &use_facet<numpunct<char> >(input.getloc()) : NULL;
+    const char dec_point = (facet != NULL) ? facet->decimal_point() : '.';
+    const bool thousands_grouping =
+            (facet != NULL) ? (!facet->grouping().empty()) : false;
+    const char thousands_sep = (facet != NULL) ? facet->thousands_sep() : ',';
+
+    unpacked_parser<T> parser(dec_point, thousands_grouping, thousands_sep);
+    while ((input) && !parser.done()) // loop while extraction from file is possible
+    {
+        parser.put(static_cast<char>(input.get()));
     }
 
-    return (error >= 0);
+    return parser.result(sign, before, after, decimalDigits);
 } // function
 
+/// Converts values extracted by parse_unpacked to decimal, see fromStream
+template<typename decimal_type, typename T>
+bool pack_unpacked(bool parsed, int sign, T before, T after, int afterDigits,
+        decimal_type &output) {
+    if (parsed) {
+        if (afterDigits <= decimal_type::decimal_points) {
+            // direct mode
+            int corrCnt = decimal_type::decimal_points - afterDigits;
+            while (corrCnt > 0) {
+                after *= 10;
+                --corrCnt;
+            }
+            output.pack(before, after);
+        } else {
+            // rounding mode - extra digits of after are rounded using integer arithmetic
+            typedef typename storage_traits<T>::unsigned_type unsigned_type;
+            const bool negative = (sign < 0);
+            const unsigned_type divisor = static_cast<unsigned_type>(
+                    storage_traits<T>::pow10(afterDigits - decimal_type::decimal_points));
+            const unsigned_type absAfter = negative ? 0 - static_cast<unsigned_type>(after)
+                    : static_cast<unsigned_type>(after);
+            const unsigned_type absBefore = negative ? 0 - static_cast<unsigned_type>(before)
+                    : static_cast<unsigned_type>(before);
+            // whole quotient is needed by rounding policy (e.g. parity for half-even)
+            unsigned_type quotient = absBefore * static_cast<unsigned_type>(
+                    storage_traits<T>::pow10(decimal_type::decimal_points))
+                    + absAfter / divisor;
+            if (decimal_type::round_policy_t::away_from_zero(negative, quotient,
+                    static_cast<unsigned_type>(absAfter % divisor), divisor)) {
+                ++quotient;
+            }
+            output.setUnbiased(static_cast<typename decimal_type::raw_data_t>(
+                    negative ? 0 - quotient : quotient));
+        }
+    } else {
+        output = decimal_type(0);
+    }
+    return parsed;
+}
+
 }
 ;
 // namespace
@@ -1505,83 +3487,213 @@ bool parse_unpacked(StreamType &input, int &sign, int64 &before, int64 &after,
 /// \result Returns true if conversion succeeded
 template<typename decimal_type, typename StreamType>
 bool fromStream(StreamType &input, decimal_type &output) {
+    typedef typename decimal_type::arithmetic_t arithmetic_type;
     int sign, afterDigits;
-    int64 before, after;
+    arithmetic_type before, after;
     bool result = details::parse_unpacked(input, sign, before, after,
             afterDigits);
-    if (result) {
-        if (afterDigits <= decimal_type::decimal_points) {
-            // direct mode
-            int corrCnt = decimal_type::decimal_points - afterDigits;
-            while (corrCnt > 0) {
-                after *= 10;
-                --corrCnt;
-            }
-            output.pack(before, after);
-        } else {
-            // rounding mode
-            int corrCnt = afterDigits;
-            int64 decimalFactor = 1;
-            while (corrCnt > 0) {
-                before *= 10;
-                decimalFactor *= 10;
-                --corrCnt;
-            }
-            decimal_type temp(before + after, decimalFactor);
-            output = temp;
-        }
-    } else {
-        output = decimal_type(0);
-    }
-    return result;
+    return details::pack_unpacked(result, sign, before, after, afterDigits, output);
 }
 
 /// Exports decimal to string
 /// Used format: {-}bbbb.aaaa where
 /// {-} is optional '-' sign character
-/// '.' is locale-dependent decimal point character
+/// '.' is decimal point character (see to_chars)
 /// bbbb is stream of digits before decimal point
 /// aaaa is stream of digits after decimal point
-template<int prec, typename roundPolicy>
-std::string &toString(const decimal<prec, roundPolicy> &arg,
+template<int prec, typename roundPolicy, typename overflowPolicy, typename storageType>
+std::string &toString(const decimal<prec, roundPolicy, overflowPolicy, storageType> &arg,
         std::string &output) {
-    using namespace std;
-
-    ostringstream out;
-    toStream(arg, out);
-    output = out.str();
+    char buffer[storage_traits<storageType>::max_chars];
+    to_chars_result res = to_chars(buffer, buffer + sizeof(buffer), arg);
+    output.assign(buffer, res.ptr);
     return output;
 }
 
 /// Exports decimal to string
 /// Used format: {-}bbbb.aaaa where
 /// {-} is optional '-' sign character
-/// '.' is locale-dependent decimal point character
+/// '.' is decimal point character (see to_chars)
 /// bbbb is stream of digits before decimal point
 /// aaaa is stream of digits after decimal point
-template<int prec, typename roundPolicy>
-std::string toString(const decimal<prec, roundPolicy> &arg) {
+template<int prec, typename roundPolicy, typename overflowPolicy, typename storageType>
+std::string toString(const decimal<prec, roundPolicy, overflowPolicy, storageType> &arg) {
     std::string res;
     toString(arg, res);
     return res;
 }
 
+namespace details {
+
+/// numpunct<char> data of stream locale, cached in iword() of the stream,
+/// so facet is queried only once per stream and after imbue() or copyfmt().
+class stream_numpunct {
+public:
+    explicit stream_numpunct(std::ios_base &stream) {
+        long &cache = stream.iword(index());
+        if ((cache & valid_flag) == 0) {
+            if ((cache & callback_flag) == 0) {
+                stream.register_callback(&on_event, index());
+            }
+            cache = callback_flag | valid_flag | load(stream.getloc());
+        }
+        m_data = cache;
+    }
+
+    char decimal_point() const {
+        return static_cast<char>(m_data & 0xff);
+    }
+
+    char thousands_sep() const {
+        return static_cast<char>((m_data >> 8) & 0xff);
+    }
+
+    bool grouping() const {
+        return (m_data & grouping_flag) != 0;
+    }
+
+private:
+    enum {
+        grouping_flag = 1 << 16,
+        valid_flag = 1 << 17,
+        callback_flag = 1 << 18
+    };
+
+    static int index() {
+        static const int value = std::ios_base::xalloc();
+        return value;
+    }
+
+    // the same defaults as in parse_unpacked for locale without numpunct<char>
+    static long load(const std::locale &loc) {
+        using namespace std;
+        if (!has_facet<numpunct<char> >(loc)) {
+            return static_cast<unsigned char>('.') | (static_cast<unsigned char>(',') << 8);
+        }
+        const numpunct<char> &facet = use_facet<numpunct<char> >(loc);
+        return static_cast<unsigned char>(facet.decimal_point())
+                | (static_cast<long>(static_cast<unsigned char>(facet.thousands_sep())) << 8)
+                | (facet.grouping().empty() ? 0 : static_cast<long>(grouping_flag));
+    }
+
+    static void on_event(std::ios_base::event event, std::ios_base &stream, int index) {
+        if ((event == std::ios_base::imbue_event) || (event == std::ios_base::copyfmt_event)) {
+            stream.iword(index) &= ~static_cast<long>(valid_flag);
+        }
+    }
+
+    long m_data;
+};
+
+// any character type: see fromStream
+template<class charT, class traits, class decimal_type>
+bool read_decimal(std::basic_istream<charT, traits> &input, decimal_type &output) {
+    return fromStream(input, output);
+}
+
+// char streams: the same as fromStream, but characters are taken directly from
+// stream buffer (get area) and numpunct data is cached
+template<class traits, class decimal_type>
+bool read_decimal(std::basic_istream<char, traits> &input, decimal_type &output) {
+    std::basic_streambuf<char, traits> *buffer = input.rdbuf();
+    if ((buffer == NULL) || !input.good() || (input.exceptions() != std::ios_base::goodbit)) {
+        return fromStream(input, output);
+    }
+    const typename std::basic_istream<char, traits>::sentry guard(input, true);
+    if (!guard) {
+        return fromStream(input, output);
+    }
+
+    typedef typename decimal_type::arithmetic_t arithmetic_type;
+    const stream_numpunct punct(input);
+    unpacked_parser<arithmetic_type> parser(punct.decimal_point(), punct.grouping(),
+            punct.thousands_sep());
+    while (!parser.done()) {
+        typename traits::int_type c = traits::eof();
+        try {
+            c = buffer->sbumpc();
+        } catch (...) {
+            input.setstate(std::ios_base::badbit);
+        }
+        // as in istream::get(), end of stream sets eofbit & failbit,
+        // returned eof is the last character seen by parser
+        if (traits::eq_int_type(c, traits::eof())) {
+            if (input.good()) {
+                input.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            }
+            parser.put(static_cast<char>(c));
+            break;
+        }
+        parser.put(traits::to_char_type(c));
+    }
+
+    int sign, afterDigits;
+    arithmetic_type before, after;
+    const bool result = parser.result(sign, before, after, afterDigits);
+    return pack_unpacked(result, sign, before, after, afterDigits, output);
+}
+
+// any character type: see toStream
+template<class charT, class traits, class decimal_type>
+void write_decimal(std::basic_ostream<charT, traits> &output, const decimal_type &arg) {
+    toStream(arg, output);
+}
+
+// char streams without field width, showpos, non-decimal base or digit grouping:
+// text from to_chars is written directly to stream buffer with one call
+template<class traits, class decimal_type>
+void write_decimal(std::basic_ostream<char, traits> &output, const decimal_type &arg) {
+    const std::ios_base::fmtflags base = output.flags() & std::ios_base::basefield;
+    if ((output.width() != 0) || ((output.flags() & std::ios_base::showpos) != 0)
+            || ((base != std::ios_base::dec) && (base != std::ios_base::fmtflags()))) {
+        toStream(arg, output);
+        return;
+    }
+    const stream_numpunct punct(output);
+    if (punct.grouping()) {
+        toStream(arg, output);
+        return;
+    }
+
+    const typename std::basic_ostream<char, traits>::sentry guard(output);
+    if (!guard) {
+        return;
+    }
+    char text[storage_traits<typename decimal_type::raw_data_t>::max_chars];
+    const to_chars_result res = to_chars(text, text + sizeof(text), arg);
+    if ((decimal_type::decimal_points > 0) && (punct.decimal_point() != '.')) {
+        res.ptr[-decimal_type::decimal_points - 1] = punct.decimal_point();
+    }
+    const std::streamsize length = static_cast<std::streamsize>(res.ptr - text);
+    try {
+        if (output.rdbuf()->sputn(text, length) != length) {
+            output.setstate(std::ios_base::badbit);
+        }
+    } catch (...) {
+        output.setstate(std::ios_base::badbit);
+    }
+}
+
+} // namespace details
+
 // input
-template<class charT, class traits, int prec, typename roundPolicy>
+template<class charT, class traits, int prec, typename roundPolicy,
+        typename overflowPolicy, typename storageType>
 std::basic_istream<charT, traits> &
 operator>>(std::basic_istream<charT, traits> & is,
-        decimal<prec, roundPolicy> & d) {
-    if (!fromStream(is, d))
+        decimal<prec, roundPolicy, overflowPolicy, storageType> & d) {
+    if (!details::read_decimal(is, d))
         d.setUnbiased(0);
     return is;
 }
 
 // output
-template<class charT, class traits, int prec, typename roundPolicy>
+template<class charT, class traits, int prec, typename roundPolicy,
+        typename overflowPolicy, typename storageType>
 std::basic_ostream<charT, traits> &
 operator<<(std::basic_ostream<charT, traits> & os,
-        const decimal<prec, roundPolicy> & d) {
-    toStream(d, os);
+        const decimal<prec, roundPolicy, overflowPolicy, storageType> & d) {
+    details::write_decimal(os, d);
     return os;
 }
 
@@ -1592,18 +3704,95 @@ operator<<(std::basic_ostream<charT, traits> & os,
 /// bbbb is stream of digits before decimal point
 /// aaaa is stream of digits after decimal point
 template<typename T>
-T fromString(const std::string &str) {
+void fromString(const std::string &str, T &out) {
     std::istringstream is(str);
+    is >> out;
+}
+
+/// Imports decimal from string using from_chars ('.' is decimal point),
+/// leading spaces and tabs are ignored, output is 0 on error.
+template<int prec, typename roundPolicy, typename overflowPolicy, typename storageType>
+void fromString(const std::string &str,
+        decimal<prec, roundPolicy, overflowPolicy, storageType> &out) {
+    details::parse_string(str.data(), str.data() + str.size(), out);
+}
+
+template<int prec, typename roundPolicy, typename overflowPolicy, typename storageType>
+void fromString(const char *str, decimal<prec, roundPolicy, overflowPolicy, storageType> &out) {
+    details::parse_string(str, str + std::strlen(str), out);
+}
+
+template<typename T>
+T fromString(const std::string &str) {
     T t;
-    is >> t;
+    fromString(str, t);
     return t;
 }
 
-template<typename T>
-void fromString(const std::string &str, T &out) {
-    std::istringstream is(str);
-    is >> out;
+#ifndef DEC_NO_CPP11
+// ----------------------------------------------------------------------------
+// User-defined literals
+// ----------------------------------------------------------------------------
+namespace details {
+
+// called only for invalid literals, so it fails compilation in constant expressions
+// and throws std::invalid_argument at run time
+inline int64 invalid_decimal_literal() {
+    throw std::invalid_argument("invalid decimal literal");
+}
+
+inline DEC_CONSTEXPR std::size_t literal_length(const char *str) {
+    return (*str == '\0') ? 0 : 1 + literal_length(str + 1);
+}
+
+template<int Prec>
+DEC_CONSTEXPR14 decimal<Prec> parse_literal(const char *str, std::size_t length) {
+    decimal<Prec> result;
+    const from_chars_result res = from_chars(str, str + length, result);
+    if ((res.ec != std::errc()) || (res.ptr != str + length))
+        result.setUnbiased(invalid_decimal_literal());
+    return result;
+}
+
+} // namespace details
+
+/// Literals for pre-defined decimal types, parsed with from_chars
+/// (at compile time if compiler supports C++14). Invalid literal (e.g. 1e5_d2,
+/// 0x10_d2 or value out of range) fails compilation in constant expressions
+/// and throws std::invalid_argument otherwise, e.g.:
+/// \code
+/// using namespace dec::literals;
+/// constexpr decimal2 fee = 1.25_d2;
+/// constexpr decimal4 tick = "0.0001"_d4;
+/// \endcode
+namespace literals {
+
+inline DEC_CONSTEXPR14 decimal2 operator"" _d2(const char *str) {
+    return details::parse_literal<2>(str, details::literal_length(str));
+}
+
+inline DEC_CONSTEXPR14 decimal2 operator"" _d2(const char *str, std::size_t length) {
+    return details::parse_literal<2>(str, length);
+}
+
+inline DEC_CONSTEXPR14 decimal4 operator"" _d4(const char *str) {
+    return details::parse_literal<4>(str, details::literal_length(str));
+}
+
+inline DEC_CONSTEXPR14 decimal4 operator"" _d4(const char *str, std::size_t length) {
+    return details::parse_literal<4>(str, length);
+}
+
+inline DEC_CONSTEXPR14 decimal6 operator"" _d6(const char *str) {
+    return details::parse_literal<6>(str, details::literal_length(str));
 }
 
+inline DEC_CONSTEXPR14 decimal6 operator"" _d6(const char *str, std::size_t length) {
+    return details::parse_literal<6>(str, length);
+}
+
+} // namespace literals
+#endif // DEC_NO_CPP11
+
 } // namespace
 #endif // _DECIMAL_H__
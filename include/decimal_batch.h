@@ -0,0 +1,1125 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_batch.h
+// Purpose:     Batch (array) operations on decimal values.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_BATCH_H__
+#define _DECIMAL_BATCH_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_batch.h
+///
+/// Elementwise operations on arrays of decimal values with the same results
+/// as scalar decimal operators. Kernels use AVX-512 or AVX2 when enabled for
+/// compilation (e.g. -mavx2, -march=native), otherwise plain loops are used.
+/// Multiplication and division by decimal use 128-bit products divided by
+/// multiplication with precomputed reciprocal of the divisor.
+///
+/// Decimal types have to use default int64 storage.
+/// Output span must have at least as many elements as the first input span.
+/// Overflow is not detected (OverflowPolicy of decimal type is ignored), except for
+/// reductions (sum, mean, min, max, argmin, argmax, count_nonzero, dot,
+/// weighted_sum), where sums are calculated exactly.
+/// format writes text of many values to a single buffer.
+///
+/// Sample usage:
+///   using namespace dec;
+///   std::vector<decimal2> prices, fees, totals;
+///   ...
+///   batch::add<decimal2>(prices, fees, totals);
+
+// ----------------------------------------------------------------------------
+// Config section
+// ----------------------------------------------------------------------------
+// - define DEC_BATCH_NO_SIMD if you want to use only portable loops
+
+#include "decimal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if !defined(DEC_BATCH_NO_SIMD) && defined(__AVX512F__)
+#define DEC_BATCH_AVX512
+#elif !defined(DEC_BATCH_NO_SIMD) && defined(__AVX2__)
+#define DEC_BATCH_AVX2
+#endif
+
+#if defined(DEC_BATCH_AVX512) || defined(DEC_BATCH_AVX2)
+#define DEC_BATCH_SIMD
+#include <immintrin.h>
+#endif
+
+namespace DEC_NAMESPACE {
+namespace batch {
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+/// Non-owning view of contiguous elements (subset of C++20 std::span).
+/// Can be created from pointer & size, array or container with data() & size().
+template<class T>
+class span {
+public:
+    typedef T element_type;
+    typedef std::size_t size_type;
+    typedef T *iterator;
+
+    span() :
+            m_data(NULL), m_size(0) {
+    }
+
+    span(T *data, size_type size) :
+            m_data(data), m_size(size) {
+    }
+
+    template<std::size_t N>
+    span(T (&data)[N]) :
+            m_data(data), m_size(N) {
+    }
+
+    template<class U>
+    span(const span<U> &other) :
+            m_data(other.data()), m_size(other.size()) {
+    }
+
+    template<class Container>
+    span(Container &container) :
+            m_data(container.data()), m_size(container.size()) {
+    }
+
+    T *data() const {
+        return m_data;
+    }
+
+    size_type size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    T &operator[](size_type index) const {
+        return m_data[index];
+    }
+
+    iterator begin() const {
+        return m_data;
+    }
+
+    iterator end() const {
+        return m_data + m_size;
+    }
+
+    span subspan(size_type offset, size_type count) const {
+        return span(m_data + offset, count);
+    }
+
+private:
+    T *m_data;
+    size_type m_size;
+};
+
+namespace details {
+
+/// Kernels load unbiased values as int64 (also to SIMD lanes), so decimal types
+/// used with batch functions have to use int64 storage.
+template<class DecimalType>
+struct int64_storage {
+    typedef typename DecimalType::raw_data_t raw_data_t;
+    enum {
+        value = (sizeof(raw_data_t) == sizeof(int64)) && std::numeric_limits<raw_data_t>::is_signed
+    };
+};
+
+#if defined(DEC_BATCH_AVX512)
+typedef __m512i vec_t;
+enum {
+    vec_width = 8
+};
+
+inline vec_t vec_load(const void *src) {
+    return _mm512_loadu_si512(src);
+}
+
+inline void vec_store(void *dst, vec_t value) {
+    _mm512_storeu_si512(dst, value);
+}
+
+inline vec_t vec_set1(int64 value) {
+    return _mm512_set1_epi64(value);
+}
+
+inline vec_t vec_add(vec_t a, vec_t b) {
+    return _mm512_add_epi64(a, b);
+}
+
+inline vec_t vec_sub(vec_t a, vec_t b) {
+    return _mm512_sub_epi64(a, b);
+}
+
+inline vec_t vec_abs(vec_t a) {
+    return _mm512_abs_epi64(a);
+}
+
+inline vec_t vec_min(vec_t a, vec_t b) {
+    return _mm512_min_epi64(a, b);
+}
+
+inline vec_t vec_max(vec_t a, vec_t b) {
+    return _mm512_max_epi64(a, b);
+}
+
+inline vec_t vec_mul(vec_t a, vec_t b) {
+#ifdef __AVX512DQ__
+    return _mm512_mullo_epi64(a, b);
+#else
+    const vec_t cross = _mm512_add_epi64(
+            _mm512_mul_epu32(_mm512_srli_epi64(a, 32), b),
+            _mm512_mul_epu32(a, _mm512_srli_epi64(b, 32)));
+    return _mm512_add_epi64(_mm512_mul_epu32(a, b), _mm512_slli_epi64(cross, 32));
+#endif
+}
+
+inline vec_t vec_xor(vec_t a, vec_t b) {
+    return _mm512_xor_si512(a, b);
+}
+
+inline vec_t vec_and(vec_t a, vec_t b) {
+    return _mm512_and_si512(a, b);
+}
+
+inline vec_t vec_shr32(vec_t a) {
+    return _mm512_srli_epi64(a, 32);
+}
+
+// bit i set when lane i of a equals lane i of b
+inline unsigned vec_eq_mask(vec_t a, vec_t b) {
+    return _mm512_cmpeq_epi64_mask(a, b);
+}
+
+// acc + 1 in lanes where a == b
+inline vec_t vec_count_eq(vec_t acc, vec_t a, vec_t b) {
+    return _mm512_mask_add_epi64(acc, _mm512_cmpeq_epi64_mask(a, b), acc, vec_set1(1));
+}
+
+#elif defined(DEC_BATCH_AVX2)
+typedef __m256i vec_t;
+enum {
+    vec_width = 4
+};
+
+inline vec_t vec_load(const void *src) {
+    return _mm256_loadu_si256(static_cast<const __m256i *>(src));
+}
+
+inline void vec_store(void *dst, vec_t value) {
+    _mm256_storeu_si256(static_cast<__m256i *>(dst), value);
+}
+
+inline vec_t vec_set1(int64 value) {
+    return _mm256_set1_epi64x(value);
+}
+
+inline vec_t vec_add(vec_t a, vec_t b) {
+    return _mm256_add_epi64(a, b);
+}
+
+inline vec_t vec_sub(vec_t a, vec_t b) {
+    return _mm256_sub_epi64(a, b);
+}
+
+inline vec_t vec_abs(vec_t a) {
+    const vec_t negMask = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+    return _mm256_sub_epi64(_mm256_xor_si256(a, negMask), negMask);
+}
+
+inline vec_t vec_min(vec_t a, vec_t b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+inline vec_t vec_max(vec_t a, vec_t b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+// low 64 bits of 64x64 product (AVX2 has only 32x32->64 multiply)
+inline vec_t vec_mul(vec_t a, vec_t b) {
+    const vec_t cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+            _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+inline vec_t vec_xor(vec_t a, vec_t b) {
+    return _mm256_xor_si256(a, b);
+}
+
+inline vec_t vec_and(vec_t a, vec_t b) {
+    return _mm256_and_si256(a, b);
+}
+
+inline vec_t vec_shr32(vec_t a) {
+    return _mm256_srli_epi64(a, 32);
+}
+
+// bit i set when lane i of a equals lane i of b
+inline unsigned vec_eq_mask(vec_t a, vec_t b) {
+    return static_cast<unsigned>(_mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))));
+}
+
+// acc + 1 in lanes where a == b
+inline vec_t vec_count_eq(vec_t acc, vec_t a, vec_t b) {
+    return _mm256_sub_epi64(acc, _mm256_cmpeq_epi64(a, b));
+}
+#endif // DEC_BATCH_AVX2
+
+// --> elementwise operations, each one in scalar and vector version
+
+struct add_op {
+    int64 operator()(int64 a, int64 b) const {
+        return a + b;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a, vec_t b) const {
+        return vec_add(a, b);
+    }
+#endif
+};
+
+struct sub_op {
+    int64 operator()(int64 a, int64 b) const {
+        return a - b;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a, vec_t b) const {
+        return vec_sub(a, b);
+    }
+#endif
+};
+
+struct min_op {
+    int64 operator()(int64 a, int64 b) const {
+        return (b < a) ? b : a;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a, vec_t b) const {
+        return vec_min(a, b);
+    }
+#endif
+};
+
+struct max_op {
+    int64 operator()(int64 a, int64 b) const {
+        return (a < b) ? b : a;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a, vec_t b) const {
+        return vec_max(a, b);
+    }
+#endif
+};
+
+struct neg_op {
+    int64 operator()(int64 a) const {
+        return -a;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a) const {
+        return vec_sub(vec_set1(0), a);
+    }
+#endif
+};
+
+struct abs_op {
+    int64 operator()(int64 a) const {
+        return (a < 0) ? -a : a;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a) const {
+        return vec_abs(a);
+    }
+#endif
+};
+
+class mul_op {
+public:
+    explicit mul_op(int64 factor) :
+            m_factor(factor) {
+    }
+    // wraps on overflow as vector version
+    int64 operator()(int64 a) const {
+        return static_cast<int64>(static_cast<uint64>(a) * static_cast<uint64>(m_factor));
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a) const {
+        return vec_mul(a, vec_set1(m_factor));
+    }
+#endif
+private:
+    int64 m_factor;
+};
+
+// result = a / 10^N rounded as in decimal_cast. Without 64-bit high multiplication
+// in AVX2 / AVX-512F vector version divides lanes one by one, each with branchless
+// multiplication by reciprocal of the constant.
+template<class RoundPolicy, int N>
+struct div_pow10_op {
+    int64 operator()(int64 a) const {
+        int64 result = 0;
+        dec_utils<RoundPolicy>::template div_rounded_pow10<N>(result, a);
+        return result;
+    }
+#ifdef DEC_BATCH_SIMD
+    vec_t operator()(vec_t a) const {
+        int64 lanes[vec_width];
+        vec_store(lanes, a);
+        for (int lane = 0; lane < vec_width; ++lane) {
+            lanes[lane] = (*this)(lanes[lane]);
+        }
+        return vec_load(lanes);
+    }
+#endif
+};
+
+// result = round(a * b / divisor) using reciprocal of divisor,
+// the same result as dec_utils<RoundPolicy>::multDiv()
+template<class RoundPolicy>
+class mult_div_op {
+public:
+    explicit mult_div_op(int64 divisor) :
+            m_divisor(divisor)
+#ifdef DEC_HAS_INT128
+            , m_divider((divisor != 0) ? dec_utils<RoundPolicy>::uabs(divisor) : 1)
+#endif
+    {
+    }
+    int64 operator()(int64 a, int64 b) const {
+#ifdef DEC_HAS_INT128
+        int64 result = 0;
+        if ((m_divisor != 0)
+                && dec_utils<RoundPolicy>::multDiv128(a, b, m_divider, m_divisor < 0, result)) {
+            return result;
+        }
+#endif
+        // overflow or division by zero - handled as in scalar version
+        return dec_utils<RoundPolicy>::multDiv(a, b, m_divisor);
+    }
+private:
+    int64 m_divisor;
+#ifdef DEC_HAS_INT128
+    invariant_divider m_divider;
+#endif
+};
+
+// <--
+
+template<class InType, class OutType, class Op>
+void unary_kernel(const InType *input, OutType *output, std::size_t count, const Op &op) {
+    std::size_t i = 0;
+#ifdef DEC_BATCH_SIMD
+    for (; i + vec_width <= count; i += vec_width) {
+        vec_store(output + i, op(vec_load(input + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i].setUnbiased(op(input[i].getUnbiased()));
+    }
+}
+
+template<class DecimalType, class Op>
+void binary_kernel(const DecimalType *a, const DecimalType *b, DecimalType *output,
+        std::size_t count, const Op &op) {
+    std::size_t i = 0;
+#ifdef DEC_BATCH_SIMD
+    for (; i + vec_width <= count; i += vec_width) {
+        vec_store(output + i, op(vec_load(a + i), vec_load(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        output[i].setUnbiased(op(a[i].getUnbiased(), b[i].getUnbiased()));
+    }
+}
+
+// reduction of values using op, requires count > 0
+template<class DecimalType, class Op>
+int64 reduce_kernel(const DecimalType *input, std::size_t count, const Op &op) {
+    int64 result = input[0].getUnbiased();
+    std::size_t i = 1;
+#ifdef DEC_BATCH_SIMD
+    if (count >= vec_width) {
+        vec_t acc = vec_load(input);
+        for (i = vec_width; i + vec_width <= count; i += vec_width) {
+            acc = op(acc, vec_load(input + i));
+        }
+        int64 lanes[vec_width];
+        vec_store(lanes, acc);
+        for (int lane = 0; lane < vec_width; ++lane) {
+            result = op(result, lanes[lane]);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        result = op(result, input[i].getUnbiased());
+    }
+    return result;
+}
+
+// index of first element with given unbiased value, count if not found
+template<class DecimalType>
+std::size_t find_kernel(const DecimalType *input, std::size_t count, int64 value) {
+    std::size_t i = 0;
+#ifdef DEC_BATCH_SIMD
+    const vec_t target = vec_set1(value);
+    for (; i + vec_width <= count; i += vec_width) {
+        if (vec_eq_mask(vec_load(input + i), target) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (input[i].getUnbiased() == value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+// number of elements with given unbiased value
+template<class DecimalType>
+std::size_t count_kernel(const DecimalType *input, std::size_t count, int64 value) {
+    std::size_t result = 0;
+    std::size_t i = 0;
+#ifdef DEC_BATCH_SIMD
+    const vec_t target = vec_set1(value);
+    vec_t acc = vec_set1(0);
+    for (; i + vec_width <= count; i += vec_width) {
+        acc = vec_count_eq(acc, vec_load(input + i), target);
+    }
+    int64 lanes[vec_width];
+    vec_store(lanes, acc);
+    for (int lane = 0; lane < vec_width; ++lane) {
+        result += static_cast<std::size_t>(lanes[lane]);
+    }
+#endif
+    for (; i < count; ++i) {
+        result += (input[i].getUnbiased() == value) ? 1 : 0;
+    }
+    return result;
+}
+
+#ifdef DEC_HAS_INT128
+// exact sum of unbiased values
+template<class DecimalType>
+int128 sum_kernel(const DecimalType *input, std::size_t count) {
+    int128 result = 0;
+    std::size_t i = 0;
+#ifdef DEC_BATCH_SIMD
+    // value + 2^63 (sign bit flipped) is split into 32-bit halves summed in separate
+    // lanes, lane sums cannot overflow until 2^32 elements per lane
+    const std::size_t blockSize = static_cast<std::size_t>(vec_width) << 24;
+    const vec_t signBit = vec_set1(DEC_MIN_INT64);
+    const vec_t lowMask = vec_set1(0xFFFFFFFF);
+    while (i + vec_width <= count) {
+        const std::size_t blockEnd = i
+                + (std::min)(blockSize, (count - i) / vec_width * vec_width);
+        const std::size_t blockCount = blockEnd - i;
+        vec_t hiSum = vec_set1(0);
+        vec_t loSum = vec_set1(0);
+        for (; i < blockEnd; i += vec_width) {
+            const vec_t biased = vec_xor(vec_load(input + i), signBit);
+            hiSum = vec_add(hiSum, vec_shr32(biased));
+            loSum = vec_add(loSum, vec_and(biased, lowMask));
+        }
+        uint64 hiLanes[vec_width];
+        uint64 loLanes[vec_width];
+        vec_store(hiLanes, hiSum);
+        vec_store(loLanes, loSum);
+        for (int lane = 0; lane < vec_width; ++lane) {
+            result += (static_cast<int128>(hiLanes[lane]) << 32) + loLanes[lane];
+        }
+        result -= static_cast<int128>(blockCount) << 63;
+    }
+#endif
+    for (; i < count; ++i) {
+        result += input[i].getUnbiased();
+    }
+    return result;
+}
+#endif // DEC_HAS_INT128
+
+#ifdef DEC_HAS_INT128
+// Exact sum of 128-bit products a * b, kept as: high * 2^64 + low.
+// Cannot overflow for less than 2^64 products.
+class product_sum {
+public:
+    product_sum() :
+            m_high(0), m_low(0) {
+    }
+
+    void add(int64 a, int64 b) {
+        const uint128 product = static_cast<uint128>(static_cast<int128>(a) * b);
+        m_high += static_cast<int64>(product >> 64);
+        m_low += static_cast<uint64>(product);
+    }
+
+    void add(const product_sum &other) {
+        m_high += other.m_high;
+        m_low += other.m_low;
+    }
+
+    // result = sum / 10^scale rounded using RoundPolicy (or sum * 10^-scale for
+    // negative scale), false if result does not fit in int64
+    template<class RoundPolicy>
+    bool get(int scale, int64 &result) const {
+        typedef dec_utils<RoundPolicy> utils;
+        // 192-bit two's complement value in 64-bit limbs, lowest first
+        const uint128 high = static_cast<uint128>(m_high);
+        const uint128 middle = (m_low >> 64) + static_cast<uint64>(high);
+        uint64 limbs[3] = { static_cast<uint64>(m_low), static_cast<uint64>(middle),
+                static_cast<uint64>(high >> 64) + static_cast<uint64>(middle >> 64) };
+        const bool negative = (limbs[2] >> 63) != 0;
+        if (negative) {
+            bool carry = true;
+            for (int i = 0; i < 3; ++i) {
+                limbs[i] = ~limbs[i] + (carry ? 1 : 0);
+                carry = carry && (limbs[i] == 0);
+            }
+        }
+
+        const uint64 limit = static_cast<uint64>(DEC_MAX_INT64) + (negative ? 1 : 0);
+        if (scale <= 0) {
+            const uint64 factor = static_cast<uint64>(utils::pow10(-scale));
+            if ((limbs[2] != 0) || (limbs[1] != 0) || (limbs[0] > limit / factor)) {
+                return false;
+            }
+            result = static_cast<int64>(negative ? 0 - limbs[0] * factor : limbs[0] * factor);
+            return true;
+        }
+
+        // divide by 10^scale in steps of at most 10^18, collecting exact remainder
+        uint128 remainder = 0;
+        uint128 divisor = 1;
+        for (int remaining = scale; remaining > 0;) {
+            const int step = (remaining < 18) ? remaining : 18;
+            const uint64 stepDivisor = static_cast<uint64>(utils::pow10(step));
+            uint64 stepRemainder = 0;
+            for (int i = 2; i >= 0; --i) {
+                limbs[i] = utils::udiv128(stepRemainder, limbs[i], stepDivisor, stepRemainder);
+            }
+            remainder += stepRemainder * divisor;
+            divisor *= stepDivisor;
+            remaining -= step;
+        }
+
+        if ((limbs[2] != 0) || (limbs[1] != 0)) {
+            return false;
+        }
+        uint64 quotient = limbs[0];
+        if (RoundPolicy::away_from_zero(negative, static_cast<uint128>(quotient), remainder, divisor)) {
+            if (quotient >= limit) {
+                return false;
+            }
+            ++quotient;
+        } else if (quotient > limit) {
+            return false;
+        }
+        result = static_cast<int64>(negative ? 0 - quotient : quotient);
+        return true;
+    }
+
+private:
+    int128 m_high;  // sum of signed upper halves of products
+    uint128 m_low;  // sum of unsigned lower halves of products
+};
+
+inline int64 unbiased_value(int64 value) {
+    return value;
+}
+
+template<class DecimalType>
+int64 unbiased_value(const DecimalType &value) {
+    return value.getUnbiased();
+}
+
+// Exact sum of products a[i] * b[i] (decimal or int64 elements).
+// Several independent sums let products of neighbouring rows be calculated in parallel.
+template<class TypeA, class TypeB>
+product_sum dot_kernel(const TypeA *a, const TypeB *b, std::size_t count) {
+    product_sum sums[4];
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        sums[0].add(unbiased_value(a[i]), unbiased_value(b[i]));
+        sums[1].add(unbiased_value(a[i + 1]), unbiased_value(b[i + 1]));
+        sums[2].add(unbiased_value(a[i + 2]), unbiased_value(b[i + 2]));
+        sums[3].add(unbiased_value(a[i + 3]), unbiased_value(b[i + 3]));
+    }
+    for (; i < count; ++i) {
+        sums[0].add(unbiased_value(a[i]), unbiased_value(b[i]));
+    }
+    sums[0].add(sums[1]);
+    sums[2].add(sums[3]);
+    sums[0].add(sums[2]);
+    return sums[0];
+}
+#endif // DEC_HAS_INT128
+
+// Length of value written by to_chars
+template<class DecimalType>
+std::size_t formatted_length(const DecimalType &value) {
+    const int64 unbiased = value.getUnbiased();
+    const uint64 absValue = dec_utils<def_round_policy>::uabs(unbiased);
+    return static_cast<std::size_t>(((unbiased < 0) ? 1 : 0)
+            + DEC_NAMESPACE::details::count_digits(absValue / DecimalFactor<DecimalType::decimal_points>::value)
+            + ((DecimalType::decimal_points > 0) ? DecimalType::decimal_points + 1 : 0));
+}
+
+// Writes values (as to_chars), each followed by separator, output has to be
+// large enough. offsets (if not NULL) receive base + position of each value.
+// Precision is known at compile time, so division by precision factor is done with
+// multiplication and fraction digits (with leading zeros) are written with fixed loop.
+template<class DecimalType>
+char *format_kernel(const DecimalType *values, std::size_t count, char separator,
+        char *output, std::size_t *offsets, std::size_t base) {
+    enum {
+        prec = DecimalType::decimal_points
+    };
+    const uint64 factor = static_cast<uint64>(DecimalFactor<prec>::value);
+    char *const first = output;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (offsets != NULL) {
+            offsets[i] = base + static_cast<std::size_t>(output - first);
+        }
+        const int64 value = values[i].getUnbiased();
+        const uint64 absValue = dec_utils<def_round_policy>::uabs(value);
+        const uint64 before = absValue / factor;
+        if (value < 0) {
+            *output++ = '-';
+        }
+        const int digits = DEC_NAMESPACE::details::count_digits(before);
+        output += digits;
+        DEC_NAMESPACE::details::write_digits_backward(output, before, digits);
+        if (prec > 0) {
+            *output = '.';
+            output += prec + 1;
+            DEC_NAMESPACE::details::write_digits_backward(output, absValue - before * factor, prec);
+        }
+        *output++ = separator;
+    }
+    return output;
+}
+
+} // namespace details
+
+// ----------------------------------------------------------------------------
+// global functions
+// ----------------------------------------------------------------------------
+
+/// output[i] = a[i] + b[i]
+template<class DecimalType>
+void add(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::binary_kernel(a.data(), b.data(), output.data(), a.size(), details::add_op());
+}
+
+/// output[i] = a[i] - b[i]
+template<class DecimalType>
+void sub(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::binary_kernel(a.data(), b.data(), output.data(), a.size(), details::sub_op());
+}
+
+/// output[i] = a[i] * b
+template<class DecimalType>
+void mul(span<const DecimalType> a, int64 b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::unary_kernel(a.data(), output.data(), a.size(), details::mul_op(b));
+}
+
+/// output[i] = a[i] * b[i], rounded as in decimal::operator*
+template<class DecimalType>
+void mul(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const details::mult_div_op<typename DecimalType::round_policy_t> op(
+            DecimalType::getPrecFactor());
+    const DecimalType *inputA = a.data();
+    const DecimalType *inputB = b.data();
+    DecimalType *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        out[i].setUnbiased(op(inputA[i].getUnbiased(), inputB[i].getUnbiased()));
+    }
+}
+
+/// output[i] = a[i] * b, rounded as in decimal::operator*
+template<class DecimalType>
+void mul(span<const DecimalType> a, const DecimalType &b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const details::mult_div_op<typename DecimalType::round_policy_t> op(
+            DecimalType::getPrecFactor());
+    const int64 factor = b.getUnbiased();
+    const DecimalType *input = a.data();
+    DecimalType *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        out[i].setUnbiased(op(input[i].getUnbiased(), factor));
+    }
+}
+
+/// output[i] = a[i] / b[i], rounded as in decimal::operator/
+template<class DecimalType>
+void div(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    typedef dec_utils<typename DecimalType::round_policy_t> utils;
+    const int64 factor = DecimalType::getPrecFactor();
+    const DecimalType *inputA = a.data();
+    const DecimalType *inputB = b.data();
+    DecimalType *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        out[i].setUnbiased(utils::multDiv(inputA[i].getUnbiased(), factor,
+                inputB[i].getUnbiased()));
+    }
+}
+
+/// output[i] = a[i] / b, rounded as in decimal::operator/
+template<class DecimalType>
+void div(span<const DecimalType> a, const DecimalType &b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const details::mult_div_op<typename DecimalType::round_policy_t> op(b.getUnbiased());
+    const int64 factor = DecimalType::getPrecFactor();
+    const DecimalType *input = a.data();
+    DecimalType *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        out[i].setUnbiased(op(input[i].getUnbiased(), factor));
+    }
+}
+
+/// output[i] = -a[i]
+template<class DecimalType>
+void neg(span<const DecimalType> a, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::unary_kernel(a.data(), output.data(), a.size(), details::neg_op());
+}
+
+/// output[i] = abs(a[i])
+template<class DecimalType>
+void abs(span<const DecimalType> a, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::unary_kernel(a.data(), output.data(), a.size(), details::abs_op());
+}
+
+/// output[i] = min(a[i], b[i])
+template<class DecimalType>
+void min(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::binary_kernel(a.data(), b.data(), output.data(), a.size(), details::min_op());
+}
+
+/// output[i] = max(a[i], b[i])
+template<class DecimalType>
+void max(span<const DecimalType> a, span<const DecimalType> b, span<DecimalType> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    details::binary_kernel(a.data(), b.data(), output.data(), a.size(), details::max_op());
+}
+
+/// output[i] = a[i].sign(), i.e. -1, 0 or +1
+template<class DecimalType>
+void sign(span<const DecimalType> a, span<int> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const DecimalType *input = a.data();
+    int *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        const int64 value = input[i].getUnbiased();
+        out[i] = static_cast<int>(value > 0) - static_cast<int>(value < 0);
+    }
+}
+
+/// output[i] = -1 if a[i] < b[i], 0 if a[i] == b[i], +1 if a[i] > b[i]
+template<class DecimalType>
+void compare(span<const DecimalType> a, span<const DecimalType> b, span<int> output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const DecimalType *inputA = a.data();
+    const DecimalType *inputB = b.data();
+    int *out = output.data();
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        const int64 valueA = inputA[i].getUnbiased();
+        const int64 valueB = inputB[i].getUnbiased();
+        out[i] = static_cast<int>(valueA > valueB) - static_cast<int>(valueA < valueB);
+    }
+}
+
+/// Converts values to different precision, output[i] = decimal_cast<OutPrec>(a[i]).
+/// When precision is reduced, rounding policy of output type is used.
+template<class OutDecimalType, class InDecimalType>
+void rescale(span<const InDecimalType> a, span<OutDecimalType> output) {
+    static_assert(details::int64_storage<OutDecimalType>::value,
+            "decimal with int64 storage required");
+    static_assert(details::int64_storage<InDecimalType>::value,
+            "decimal with int64 storage required");
+    const int inPrec = InDecimalType::decimal_points;
+    const int outPrec = OutDecimalType::decimal_points;
+    if (outPrec >= inPrec) {
+        details::unary_kernel(a.data(), output.data(), a.size(),
+                details::mul_op(DecimalFactorDiff<outPrec - inPrec>::value));
+    } else {
+        details::unary_kernel(a.data(), output.data(), a.size(), details::div_pow10_op<
+                typename OutDecimalType::round_policy_t, (inPrec > outPrec) ? inPrec - outPrec : 0>());
+    }
+}
+
+/// Exact sum of values
+template<class DecimalType>
+decimal_accumulator<DecimalType::decimal_points> accumulate(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    decimal_accumulator<DecimalType::decimal_points> result;
+#ifdef DEC_HAS_INT128
+    const uint128 total = static_cast<uint128>(details::sum_kernel(a.data(), a.size()));
+    result.setUnbiased(static_cast<int64>(total >> 64), static_cast<uint64>(total));
+#else
+    for (std::size_t i = 0, count = a.size(); i < count; ++i) {
+        result += a[i];
+    }
+#endif
+    return result;
+}
+
+/// Exact sum of values. Returns false and leaves output unchanged when sum
+/// does not fit in DecimalType.
+template<class DecimalType>
+bool sum(span<const DecimalType> a, DecimalType &output) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    return accumulate(a).getAsDecimal(output);
+}
+
+/// Arithmetic mean of values rounded using rounding policy of DecimalType,
+/// zero for empty span. Calculated from exact sum, so it cannot overflow.
+template<class DecimalType>
+DecimalType mean(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    typedef typename DecimalType::round_policy_t round_policy;
+    DecimalType result;
+    if (a.empty()) {
+        return result;
+    }
+    const uint64 divisor = a.size();
+    int64 value = 0;
+#ifdef DEC_HAS_INT128
+    const int128 total = details::sum_kernel(a.data(), a.size());
+    const bool negative = (total < 0);
+    const uint128 magnitude = negative ? 0 - static_cast<uint128>(total) : static_cast<uint128>(total);
+    uint64 remainder = 0;
+    // |total| <= count * 2^63, so quotient fits in 64 bits
+    const uint64 quotient = dec_utils<round_policy>::udiv128(static_cast<uint64>(magnitude >> 64),
+            static_cast<uint64>(magnitude), divisor, remainder);
+    // mean is between min and max value, so rounded mean also fits
+    dec_utils<round_policy>::roundQuotient(negative, quotient, remainder, divisor, value);
+#else
+    // sum of quotients and remainders of value / count, remainders kept in (-count, count)
+    const int64 count = static_cast<int64>(divisor);
+    int64 quotient = 0;
+    int64 remainder = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const int64 item = a[i].getUnbiased();
+        quotient += item / count;
+        remainder += item % count;
+        if (remainder >= count) {
+            remainder -= count;
+            ++quotient;
+        } else if (remainder <= -count) {
+            remainder += count;
+            --quotient;
+        }
+    }
+    if ((quotient > 0) && (remainder < 0)) {
+        remainder += count;
+        --quotient;
+    } else if ((quotient < 0) && (remainder > 0)) {
+        remainder -= count;
+        ++quotient;
+    }
+    const bool negative = (quotient < 0) || (remainder < 0);
+    value = quotient;
+    if (round_policy::away_from_zero(negative, dec_utils<round_policy>::uabs(quotient),
+            dec_utils<round_policy>::uabs(remainder), divisor)) {
+        value += negative ? -1 : 1;
+    }
+#endif
+    result.setUnbiased(value);
+    return result;
+}
+
+/// Smallest value, requires non-empty span
+template<class DecimalType>
+DecimalType min(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    DecimalType result;
+    result.setUnbiased(details::reduce_kernel(a.data(), a.size(), details::min_op()));
+    return result;
+}
+
+/// Largest value, requires non-empty span
+template<class DecimalType>
+DecimalType max(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    DecimalType result;
+    result.setUnbiased(details::reduce_kernel(a.data(), a.size(), details::max_op()));
+    return result;
+}
+
+/// Index of first smallest value, a.size() for empty span
+template<class DecimalType>
+std::size_t argmin(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    if (a.empty()) {
+        return 0;
+    }
+    return details::find_kernel(a.data(), a.size(),
+            details::reduce_kernel(a.data(), a.size(), details::min_op()));
+}
+
+/// Index of first largest value, a.size() for empty span
+template<class DecimalType>
+std::size_t argmax(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    if (a.empty()) {
+        return 0;
+    }
+    return details::find_kernel(a.data(), a.size(),
+            details::reduce_kernel(a.data(), a.size(), details::max_op()));
+}
+
+/// Number of values different from zero
+template<class DecimalType>
+std::size_t count_nonzero(span<const DecimalType> a) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    return a.size() - details::count_kernel(a.data(), a.size(), 0);
+}
+
+#ifdef DEC_HAS_INT128
+/// Sum of a[i] * b[i] calculated exactly (128-bit products) and rounded once
+/// to precision of OutDecimalType using its rounding policy. Returns false and
+/// leaves output unchanged when result does not fit in OutDecimalType.
+/// Uses min(a.size(), b.size()) elements.
+template<class OutDecimalType, class DecimalTypeA, class DecimalTypeB>
+bool dot(span<const DecimalTypeA> a, span<const DecimalTypeB> b, OutDecimalType &output) {
+    static_assert(details::int64_storage<OutDecimalType>::value,
+            "decimal with int64 storage required");
+    static_assert(details::int64_storage<DecimalTypeA>::value,
+            "decimal with int64 storage required");
+    static_assert(details::int64_storage<DecimalTypeB>::value,
+            "decimal with int64 storage required");
+    const std::size_t size = (a.size() < b.size()) ? a.size() : b.size();
+    int64 result = 0;
+    if (!details::dot_kernel(a.data(), b.data(), size).template get<
+            typename OutDecimalType::round_policy_t>(static_cast<int>(DecimalTypeA::decimal_points)
+            + static_cast<int>(DecimalTypeB::decimal_points)
+            - static_cast<int>(OutDecimalType::decimal_points), result)) {
+        return false;
+    }
+    output.setUnbiased(result);
+    return true;
+}
+
+/// Sum of values[i] * weights[i] for integer weights (e.g. quantities),
+/// calculated exactly and rounded once to precision of OutDecimalType.
+/// Returns false and leaves output unchanged when result does not fit in
+/// OutDecimalType. Uses min(values.size(), weights.size()) elements.
+template<class OutDecimalType, class DecimalType>
+bool weighted_sum(span<const DecimalType> values, span<const int64> weights,
+        OutDecimalType &output) {
+    static_assert(details::int64_storage<OutDecimalType>::value,
+            "decimal with int64 storage required");
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const std::size_t size = (values.size() < weights.size()) ? values.size() : weights.size();
+    int64 result = 0;
+    if (!details::dot_kernel(values.data(), weights.data(), size).template get<
+            typename OutDecimalType::round_policy_t>(static_cast<int>(DecimalType::decimal_points)
+            - static_cast<int>(OutDecimalType::decimal_points), result)) {
+        return false;
+    }
+    output.setUnbiased(result);
+    return true;
+}
+#endif // DEC_HAS_INT128
+
+/// Maximum number of chars written by format() for count values of DecimalType,
+/// SIZE_MAX if it does not fit in std::size_t
+template<class DecimalType>
+std::size_t format_capacity(std::size_t count) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    const std::size_t valueSize = storage_traits<int64>::max_chars + 1;
+    if (count > (std::numeric_limits<std::size_t>::max)() / valueSize) {
+        return (std::numeric_limits<std::size_t>::max)();
+    }
+    return count * valueSize;
+}
+
+/// Writes values as text (see to_chars) to single buffer [first, last), each value
+/// is followed by separator. If offsets is not empty, offsets[i] is position of
+/// value i (from first) and offsets[a.size()] is length of output, so offsets
+/// needs a.size() + 1 elements. Returns std::errc::value_too_large (with ptr == last)
+/// if output is too small and std::errc::invalid_argument (with ptr == first) if
+/// offsets is not empty and too small, nothing is written in both cases.
+template<class DecimalType>
+to_chars_result format(span<const DecimalType> a, char *first, char *last,
+        char separator = '\n', span<std::size_t> offsets = span<std::size_t>()) {
+    static_assert(details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    to_chars_result result;
+    if (!offsets.empty() && (offsets.size() <= a.size())) {
+        result.ptr = first;
+        result.ec = std::errc::invalid_argument;
+        return result;
+    }
+    if (static_cast<std::size_t>(last - first) < format_capacity<DecimalType>(a.size())) {
+        // exact length is calculated only if buffer can be too small
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            length += details::formatted_length(a[i]) + 1;
+        }
+        if (static_cast<std::size_t>(last - first) < length) {
+            result.ptr = last;
+            result.ec = std::errc::value_too_large;
+            return result;
+        }
+    }
+
+    std::size_t *positions = offsets.empty() ? NULL : offsets.data();
+    result.ptr = details::format_kernel(a.data(), a.size(), separator, first, positions, 0);
+    if (positions != NULL) {
+        positions[a.size()] = static_cast<std::size_t>(result.ptr - first);
+    }
+    result.ec = std::errc();
+    return result;
+}
+
+} // namespace batch
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_BATCH_H__
@@ -0,0 +1,459 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_codec.h
+// Purpose:     Compact binary encoding of decimal arrays.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_CODEC_H__
+#define _DECIMAL_CODEC_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_codec.h
+///
+/// Binary encoding of arrays of decimal values (with default int64 storage),
+/// which needs much less space than raw unbiased values when values are small.
+/// Unbiased values are stored as zigzag integers (small negative and positive
+/// values have short codes), optionally as differences to previous value,
+/// which suits sorted values and time series of prices:
+/// - varint: 7 bits per byte, the highest bit marks continuation
+/// - group_varint: groups of 4 values with 2-byte tag of value lengths
+///   (1-8 bytes), decoded without branches per byte
+///
+/// Each block of values starts with header: magic "DC", version & encoding,
+/// precision and number of values. Blocks can be concatenated, decode()
+/// returns position after the block. Input is validated while decoding, so
+/// corrupted data is reported as error and never read out of bounds.
+///
+/// Sample usage:
+///   using namespace dec;
+///   std::vector<decimal4> prices;
+///   ...
+///   std::vector<char> buffer(codec::capacity(prices.size()));
+///   to_chars_result res = codec::encode<decimal4>(prices, buffer.data(),
+///           buffer.data() + buffer.size(), codec::delta_varint);
+///   ...
+///   decimal_column<4> loaded;
+///   from_chars_result in = codec::decode(buffer.data(), res.ptr, loaded);
+
+#include "decimal_batch.h"
+
+#include <cstring>
+
+namespace DEC_NAMESPACE {
+namespace codec {
+
+// ----------------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------------
+enum encoding {
+    varint = 0,
+    delta_varint = 1,
+    group_varint = 2,
+    delta_group_varint = 3
+};
+
+enum {
+    format_version = 1,
+    // magic, version & encoding, precision, number of values (varint)
+    max_header_size = 2 + 1 + 1 + 10,
+    // the longest varint, group varint needs 8.5 bytes
+    max_value_size = 10
+};
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+/// Description of encoded block
+struct header {
+    encoding method;
+    int precision;
+    std::size_t count;
+};
+
+namespace details {
+
+inline uint64 zigzag_encode(int64 value) {
+    const uint64 bits = static_cast<uint64>(value);
+    return (bits << 1) ^ (0 - (bits >> 63));
+}
+
+inline int64 zigzag_decode(uint64 value) {
+    return static_cast<int64>((value >> 1) ^ (0 - (value & 1)));
+}
+
+inline bool is_delta(encoding method) {
+    return (method == delta_varint) || (method == delta_group_varint);
+}
+
+inline bool is_group(encoding method) {
+    return (method == group_varint) || (method == delta_group_varint);
+}
+
+inline std::size_t varint_size(uint64 value) {
+    std::size_t result = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++result;
+    }
+    return result;
+}
+
+inline unsigned char *put_varint(unsigned char *output, uint64 value) {
+    while (value >= 0x80) {
+        *output++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *output++ = static_cast<unsigned char>(value);
+    return output;
+}
+
+// Returns NULL for truncated varint or varint longer than 64 bits
+inline const unsigned char *get_varint(const unsigned char *input, const unsigned char *last,
+        uint64 &value) {
+    uint64 result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (input == last) {
+            return NULL;
+        }
+        const uint64 byte = *input++;
+        if ((shift == 63) && (byte > 1)) {
+            return NULL;
+        }
+        result |= (byte & 0x7f) << shift;
+        if (byte < 0x80) {
+            value = result;
+            return input;
+        }
+    }
+    return NULL;
+}
+
+// Number of bytes without leading zero bytes, at least one
+inline unsigned byte_length(uint64 value) {
+    unsigned result = 1;
+    while ((result < 8) && ((value >> (8 * result)) != 0)) {
+        ++result;
+    }
+    return result;
+}
+
+// 8 bytes in little endian order
+inline uint64 load_le64(const unsigned char *input) {
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) \
+        || defined(_M_IX86) || defined(_M_X64)
+    uint64 result;
+    std::memcpy(&result, input, sizeof(result));
+    return result;
+#else
+    uint64 result = 0;
+    for (int i = 7; i >= 0; --i) {
+        result = (result << 8) | input[i];
+    }
+    return result;
+#endif
+}
+
+// Zigzag code of value i, (wrapping) difference to previous value for delta
+// encoding, so decoding restores any sequence exactly.
+template<class DecimalType>
+class value_reader {
+public:
+    value_reader(const DecimalType *values, bool delta) :
+            m_values(values), m_delta(delta), m_previous(0) {
+    }
+
+    uint64 operator()(std::size_t i) {
+        const uint64 value = static_cast<uint64>(m_values[i].getUnbiased());
+        const uint64 result = zigzag_encode(static_cast<int64>(value - m_previous));
+        if (m_delta) {
+            m_previous = value;
+        }
+        return result;
+    }
+
+private:
+    const DecimalType *m_values;
+    bool m_delta;
+    uint64 m_previous;
+};
+
+template<class DecimalType>
+std::size_t encoded_size(const DecimalType *values, std::size_t count, encoding method) {
+    value_reader<DecimalType> reader(values, is_delta(method));
+    std::size_t result = 4 + varint_size(count);
+    if (is_group(method)) {
+        result += 2 * ((count + 3) / 4);
+        for (std::size_t i = 0; i < count; ++i) {
+            result += byte_length(reader(i));
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            result += varint_size(reader(i));
+        }
+    }
+    return result;
+}
+
+template<class DecimalType>
+unsigned char *encode_kernel(const DecimalType *values, std::size_t count, encoding method,
+        unsigned char *output) {
+    value_reader<DecimalType> reader(values, is_delta(method));
+    if (!is_group(method)) {
+        for (std::size_t i = 0; i < count; ++i) {
+            output = put_varint(output, reader(i));
+        }
+        return output;
+    }
+
+    for (std::size_t i = 0; i < count; i += 4) {
+        unsigned char *tagOutput = output;
+        output += 2;
+        unsigned tag = 0;
+        for (std::size_t j = 0; (j < 4) && (i + j < count); ++j) {
+            uint64 value = reader(i + j);
+            const unsigned length = byte_length(value);
+            tag |= (length - 1) << (4 * j);
+            for (unsigned k = 0; k < length; ++k) {
+                *output++ = static_cast<unsigned char>(value);
+                value >>= 8;
+            }
+        }
+        tagOutput[0] = static_cast<unsigned char>(tag);
+        tagOutput[1] = static_cast<unsigned char>(tag >> 8);
+    }
+    return output;
+}
+
+// Restores unbiased values from zigzag codes and multiplies them by factor
+// (precision of output can be higher than precision of encoded values).
+template<class Column>
+class value_writer {
+public:
+    typedef typename Column::value_type value_type;
+
+    value_writer(Column &output, bool delta, int64 factor) :
+            m_output(output), m_delta(delta), m_factor(factor), m_previous(0) {
+    }
+
+    bool operator()(std::size_t i, uint64 code) {
+        uint64 value = static_cast<uint64>(zigzag_decode(code));
+        if (m_delta) {
+            value += m_previous;
+            m_previous = value;
+        }
+        int64 unbiased = static_cast<int64>(value);
+        if (m_factor != 1) {
+            if ((unbiased > DEC_MAX_INT64 / m_factor) || (unbiased < DEC_MIN_INT64 / m_factor)) {
+                return false;
+            }
+            unbiased *= m_factor;
+        }
+        value_type item;
+        item.setUnbiased(unbiased);
+        m_output[i] = item;
+        return true;
+    }
+
+private:
+    Column &m_output;
+    bool m_delta;
+    int64 m_factor;
+    uint64 m_previous;
+};
+
+template<class Column>
+std::errc decode_varint(const unsigned char *&input, const unsigned char *last,
+        std::size_t count, value_writer<Column> &writer) {
+    for (std::size_t i = 0; i < count; ++i) {
+        uint64 code;
+        input = get_varint(input, last, code);
+        if (input == NULL) {
+            return std::errc::invalid_argument;
+        }
+        if (!writer(i, code)) {
+            return std::errc::result_out_of_range;
+        }
+    }
+    return std::errc();
+}
+
+template<class Column>
+std::errc decode_group_varint(const unsigned char *&input, const unsigned char *last,
+        std::size_t count, value_writer<Column> &writer) {
+    std::size_t i = 0;
+    // full groups far enough from end of input: values are loaded with 8-byte
+    // reads and masked to their length
+    while ((count - i >= 4) && (last - input >= 2 + 4 * 8)) {
+        const unsigned tag = input[0] | (static_cast<unsigned>(input[1]) << 8);
+        if ((tag & 0x8888) != 0) {
+            return std::errc::invalid_argument;
+        }
+        input += 2;
+        for (unsigned j = 0; j < 4; ++j) {
+            const unsigned length = ((tag >> (4 * j)) & 7) + 1;
+            uint64 code = load_le64(input);
+            if (length < 8) {
+                code &= (static_cast<uint64>(1) << (8 * length)) - 1;
+            }
+            input += length;
+            if (!writer(i + j, code)) {
+                return std::errc::result_out_of_range;
+            }
+        }
+        i += 4;
+    }
+
+    // the rest with bounds checks for each value
+    while (i < count) {
+        if (last - input < 2) {
+            return std::errc::invalid_argument;
+        }
+        const unsigned tag = input[0] | (static_cast<unsigned>(input[1]) << 8);
+        const unsigned groupSize = (count - i < 4) ? static_cast<unsigned>(count - i) : 4;
+        // unused lengths of the last group are zero
+        if (((tag & 0x8888) != 0) || ((tag >> (4 * groupSize)) != 0)) {
+            return std::errc::invalid_argument;
+        }
+        input += 2;
+        for (unsigned j = 0; j < groupSize; ++j) {
+            const unsigned length = ((tag >> (4 * j)) & 7) + 1;
+            if (static_cast<std::size_t>(last - input) < length) {
+                return std::errc::invalid_argument;
+            }
+            uint64 code = 0;
+            for (unsigned k = length; k > 0; --k) {
+                code = (code << 8) | input[k - 1];
+            }
+            input += length;
+            if (!writer(i + j, code)) {
+                return std::errc::result_out_of_range;
+            }
+        }
+        i += groupSize;
+    }
+    return std::errc();
+}
+
+} // namespace details
+
+// ----------------------------------------------------------------------------
+// global functions
+// ----------------------------------------------------------------------------
+
+/// Maximum size of block with count values, SIZE_MAX if it does not fit in std::size_t
+inline std::size_t capacity(std::size_t count) {
+    const std::size_t maxSize = (std::numeric_limits<std::size_t>::max)();
+    if (count > (maxSize - max_header_size) / max_value_size) {
+        return maxSize;
+    }
+    return max_header_size + count * max_value_size;
+}
+
+/// Writes block with values to [first, last). Returns std::errc::value_too_large
+/// (with ptr == last) if output is too small.
+template<class DecimalType>
+to_chars_result encode(batch::span<const DecimalType> values, char *first, char *last,
+        encoding method = delta_varint) {
+    static_assert(batch::details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    to_chars_result result;
+    if ((static_cast<std::size_t>(last - first) < capacity(values.size()))
+            && (static_cast<std::size_t>(last - first)
+                    < details::encoded_size(values.data(), values.size(), method))) {
+        result.ptr = last;
+        result.ec = std::errc::value_too_large;
+        return result;
+    }
+
+    unsigned char *output = reinterpret_cast<unsigned char *>(first);
+    *output++ = 'D';
+    *output++ = 'C';
+    *output++ = static_cast<unsigned char>((format_version << 4) | method);
+    *output++ = static_cast<unsigned char>(DecimalType::decimal_points);
+    output = details::put_varint(output, values.size());
+    output = details::encode_kernel(values.data(), values.size(), method, output);
+    result.ptr = reinterpret_cast<char *>(output);
+    result.ec = std::errc();
+    return result;
+}
+
+/// Reads header of block from [first, last), ptr of result is start of values.
+/// Returns std::errc::invalid_argument if input is not a valid header.
+inline from_chars_result read_header(const char *first, const char *last, header &output) {
+    from_chars_result result;
+    result.ptr = first;
+    result.ec = std::errc::invalid_argument;
+
+    const unsigned char *input = reinterpret_cast<const unsigned char *>(first);
+    const unsigned char *end = reinterpret_cast<const unsigned char *>(last);
+    if ((end - input < 4) || (input[0] != 'D') || (input[1] != 'C')
+            || ((input[2] >> 4) != format_version) || ((input[2] & 0x0f) > delta_group_varint)
+            || (input[3] > max_decimal_points)) {
+        return result;
+    }
+    uint64 count;
+    const unsigned char *values = details::get_varint(input + 4, end, count);
+    if (values == NULL) {
+        return result;
+    }
+    output.method = static_cast<encoding>(input[2] & 0x0f);
+    output.precision = input[3];
+    output.count = static_cast<std::size_t>(count);
+    result.ptr = reinterpret_cast<const char *>(values);
+    result.ec = std::errc();
+    return result;
+}
+
+/// Reads block from [first, last) to output, which is a container of decimal
+/// values with resize() and operator[] (e.g. decimal_column or std::vector).
+/// Values encoded with lower precision are rescaled to precision of output.
+/// Returns position after the block or error:
+/// - std::errc::invalid_argument for invalid or truncated input
+/// - std::errc::result_out_of_range if precision of values is higher than
+///   precision of output or rescaled value does not fit
+/// On error output is empty.
+template<class Column>
+from_chars_result decode(const char *first, const char *last, Column &output) {
+    static_assert(batch::details::int64_storage<typename Column::value_type>::value,
+            "decimal with int64 storage required");
+    header info;
+    from_chars_result result = read_header(first, last, info);
+    if (result.ec != std::errc()) {
+        output.resize(0);
+        return result;
+    }
+    const int outputPrecision = Column::value_type::decimal_points;
+    const unsigned char *input = reinterpret_cast<const unsigned char *>(result.ptr);
+    const unsigned char *end = reinterpret_cast<const unsigned char *>(last);
+    if (info.precision > outputPrecision) {
+        result.ec = std::errc::result_out_of_range;
+    } else if (info.count > static_cast<std::size_t>(end - input)) {
+        // each value has at least one byte, corrupted count is detected before resize
+        result.ec = std::errc::invalid_argument;
+    }
+    if (result.ec != std::errc()) {
+        output.resize(0);
+        return result;
+    }
+
+    output.resize(info.count);
+    details::value_writer<Column> writer(output, details::is_delta(info.method),
+            dec_utils<def_round_policy>::pow10(outputPrecision - info.precision));
+    result.ec = details::is_group(info.method)
+            ? details::decode_group_varint(input, end, info.count, writer)
+            : details::decode_varint(input, end, info.count, writer);
+    if (result.ec != std::errc()) {
+        output.resize(0);
+        return result;
+    }
+    result.ptr = reinterpret_cast<const char *>(input);
+    return result;
+}
+
+} // namespace codec
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_CODEC_H__
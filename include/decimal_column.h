@@ -0,0 +1,242 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_column.h
+// Purpose:     Columnar container of decimal values with aggregations.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_COLUMN_H__
+#define _DECIMAL_COLUMN_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_column.h
+///
+/// Column of decimal values of one type stored in contiguous memory aligned
+/// for vector loads. Elements are decimal objects, which have the same layout
+/// as their int64 storage, so column can be viewed as span of decimals
+/// (usable with all batch:: functions) or as span of unbiased int64 values
+/// without copying.
+///
+/// Sample usage:
+///   using namespace dec;
+///   decimal_column<2> prices;
+///   prices.push_back(decimal2("12.50"));
+///   ...
+///   decimal2 total;
+///   if (prices.sum(total))
+///       cout << "Total: " << total << ", average: " << prices.mean() << endl;
+
+#include "decimal_batch.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+/// Allocator returning memory aligned to Alignment bytes (power of 2).
+template<class T, std::size_t Alignment>
+class aligned_allocator {
+public:
+    typedef T value_type;
+
+    template<class U>
+    struct rebind {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator() {
+    }
+
+    template<class U>
+    aligned_allocator(const aligned_allocator<U, Alignment> &) {
+    }
+
+    T *allocate(std::size_t count) {
+        if (count > (static_cast<std::size_t>(-1) - Alignment - sizeof(void *)) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        // original pointer is stored just before aligned block
+        void *block = std::malloc(count * sizeof(T) + Alignment + sizeof(void *));
+        if (block == NULL) {
+            throw std::bad_alloc();
+        }
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block) + sizeof(void *);
+        void **aligned = reinterpret_cast<void **>((address + Alignment - 1) & ~(Alignment - 1));
+        aligned[-1] = block;
+        return reinterpret_cast<T *>(aligned);
+    }
+
+    void deallocate(T *ptr, std::size_t) {
+        if (ptr != NULL) {
+            std::free(reinterpret_cast<void **>(ptr)[-1]);
+        }
+    }
+
+    template<class U>
+    bool operator==(const aligned_allocator<U, Alignment> &) const {
+        return true;
+    }
+
+    template<class U>
+    bool operator!=(const aligned_allocator<U, Alignment> &) const {
+        return false;
+    }
+};
+
+} // namespace details
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+template<int Prec, class RoundPolicy = def_round_policy,
+        class OverflowPolicy = unchecked_overflow_policy>
+class decimal_column {
+public:
+    typedef decimal<Prec, RoundPolicy, OverflowPolicy> value_type;
+    typedef std::size_t size_type;
+    typedef value_type *iterator;
+    typedef const value_type *const_iterator;
+    enum {
+        alignment = 64 // cache line, also width of AVX-512 vector
+    };
+    static_assert(batch::details::int64_storage<value_type>::value,
+            "decimal with int64 storage required");
+
+    decimal_column() {
+    }
+
+    explicit decimal_column(size_type count, const value_type &value = value_type()) :
+            m_values(count, value) {
+    }
+
+    explicit decimal_column(batch::span<const value_type> values) :
+            m_values(values.begin(), values.end()) {
+    }
+
+    size_type size() const {
+        return m_values.size();
+    }
+
+    bool empty() const {
+        return m_values.empty();
+    }
+
+    size_type capacity() const {
+        return m_values.capacity();
+    }
+
+    void reserve(size_type count) {
+        m_values.reserve(count);
+    }
+
+    void resize(size_type count, const value_type &value = value_type()) {
+        m_values.resize(count, value);
+    }
+
+    void clear() {
+        m_values.clear();
+    }
+
+    void push_back(const value_type &value) {
+        m_values.push_back(value);
+    }
+
+    void assign(batch::span<const value_type> values) {
+        m_values.assign(values.begin(), values.end());
+    }
+
+    value_type &operator[](size_type index) {
+        return m_values[index];
+    }
+
+    const value_type &operator[](size_type index) const {
+        return m_values[index];
+    }
+
+    value_type *data() {
+        return m_values.data();
+    }
+
+    const value_type *data() const {
+        return m_values.data();
+    }
+
+    iterator begin() {
+        return data();
+    }
+
+    iterator end() {
+        return data() + size();
+    }
+
+    const_iterator begin() const {
+        return data();
+    }
+
+    const_iterator end() const {
+        return data() + size();
+    }
+
+    /// View of elements as decimal values
+    batch::span<value_type> values() {
+        return batch::span<value_type>(data(), size());
+    }
+
+    batch::span<const value_type> values() const {
+        return batch::span<const value_type>(data(), size());
+    }
+
+    /// View of elements as unbiased values (see decimal::getUnbiased)
+    batch::span<int64> unbiased() {
+        return batch::span<int64>(reinterpret_cast<int64 *>(data()), size());
+    }
+
+    batch::span<const int64> unbiased() const {
+        return batch::span<const int64>(reinterpret_cast<const int64 *>(data()), size());
+    }
+
+    /// Exact sum of values, returns false when it does not fit in value_type
+    bool sum(value_type &result) const {
+        return batch::sum(values(), result);
+    }
+
+    /// Mean value rounded using RoundPolicy, zero for empty column
+    value_type mean() const {
+        return batch::mean(values());
+    }
+
+    /// Smallest value, requires non-empty column
+    value_type min() const {
+        return batch::min(values());
+    }
+
+    /// Largest value, requires non-empty column
+    value_type max() const {
+        return batch::max(values());
+    }
+
+    /// Index of first smallest value, size() for empty column
+    size_type argmin() const {
+        return batch::argmin(values());
+    }
+
+    /// Index of first largest value, size() for empty column
+    size_type argmax() const {
+        return batch::argmax(values());
+    }
+
+    size_type count_nonzero() const {
+        return batch::count_nonzero(values());
+    }
+
+private:
+    std::vector<value_type, details::aligned_allocator<value_type, alignment> > m_values;
+};
+
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_COLUMN_H__
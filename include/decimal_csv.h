@@ -0,0 +1,318 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_csv.h
+// Purpose:     Bulk parsing of decimal columns from CSV text.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_CSV_H__
+#define _DECIMAL_CSV_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_csv.h
+///
+/// csv_reader converts selected fields of delimited text (in memory or
+/// memory-mapped file) directly to columns of decimal values.
+/// Separators are found with SSE2 / AVX2 when enabled for compilation,
+/// fields are converted with from_chars (8 digits at once with SWAR).
+/// Large input is divided into chunks processed by several threads (see
+/// decimal_parallel.h): rows are counted first, so every chunk knows index
+/// of its first row and writes values directly to output columns.
+///
+/// Format: rows are separated with '\n' (optional '\r' before it is ignored),
+/// fields with single delimiter character. Quoting is not supported, so
+/// delimiter may not appear inside of any field. Decimal fields use '.' as
+/// decimal point (see from_chars), value is rounded with rounding policy of
+/// column type if it has more fraction digits.
+///
+/// Invalid or missing fields are stored as zero and reported in error list
+/// (ordered by row), so one bad row does not stop loading of file.
+///
+/// Sample usage:
+///   using namespace dec;
+///   decimal_column<4> prices;
+///   std::vector<decimal2> quantities;
+///   csv_reader reader(';', true); // with header row
+///   reader.column(2, prices).column(3, quantities);
+///   std::vector<csv_error> errors;
+///   std::size_t rows = reader.parse(text, text + length, errors);
+
+// ----------------------------------------------------------------------------
+// Config section
+// ----------------------------------------------------------------------------
+// - define DEC_BATCH_NO_SIMD if you want to use only portable loops
+
+#include "decimal_parallel.h"
+
+#include <cstring>
+
+#if !defined(DEC_BATCH_NO_SIMD) && defined(__AVX2__)
+#define DEC_CSV_AVX2
+#include <immintrin.h>
+#elif !defined(DEC_BATCH_NO_SIMD) && defined(__SSE2__)
+#define DEC_CSV_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace DEC_NAMESPACE {
+
+/// Invalid (std::errc::invalid_argument) or too large (std::errc::result_out_of_range)
+/// value of field. Missing field is reported as invalid with offset of row end
+/// ('\r' or '\n' ending the row, or end of input).
+struct csv_error {
+    std::size_t row;    // index of data row (header is not counted)
+    std::size_t field;  // index of field in row
+    std::size_t offset; // position of field in input
+    std::errc ec;
+};
+
+namespace details {
+
+/// Position of the first delimiter or '\n' in [first, last), last if not found
+inline const char *csv_find_separator(const char *first, const char *last, char delimiter) {
+#if defined(DEC_CSV_AVX2)
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    while (last - first >= 32) {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(
+                _mm256_cmpeq_epi8(chars, newlines), _mm256_cmpeq_epi8(chars, delimiters))));
+        if (mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+        first += 32;
+    }
+#elif defined(DEC_CSV_SSE2)
+    const __m128i newlines = _mm_set1_epi8('\n');
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    while (last - first >= 16) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(
+                _mm_cmpeq_epi8(chars, newlines), _mm_cmpeq_epi8(chars, delimiters))));
+        if (mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+        first += 16;
+    }
+#endif
+    while ((first != last) && (*first != '\n') && (*first != delimiter)) {
+        ++first;
+    }
+    return first;
+}
+
+/// Position of the first '\n' in [first, last), last if not found
+inline const char *csv_find_newline(const char *first, const char *last) {
+    const void *found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+    return (found != NULL) ? static_cast<const char *>(found) : last;
+}
+
+/// Number of '\n' characters in [first, last)
+inline std::size_t csv_count_newlines(const char *first, const char *last) {
+    std::size_t result = 0;
+#if defined(DEC_CSV_AVX2)
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    while (last - first >= 32) {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        result += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, newlines)))));
+        first += 32;
+    }
+#elif defined(DEC_CSV_SSE2)
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while (last - first >= 16) {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        result += static_cast<std::size_t>(__builtin_popcount(static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(chars, newlines)))));
+        first += 16;
+    }
+#endif
+    for (; first != last; ++first) {
+        if (*first == '\n') {
+            ++result;
+        }
+    }
+    return result;
+}
+
+} // namespace details
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+class csv_reader {
+public:
+    explicit csv_reader(char delimiter = ',', bool header = false) :
+            m_delimiter(delimiter), m_header(header) {
+    }
+
+    /// Adds output for field with given index (starting from 0).
+    /// Column is a container of decimal values with resize() and operator[],
+    /// e.g. decimal_column or std::vector, and must exist during parse().
+    template<class Column>
+    csv_reader &column(std::size_t field, Column &output) {
+        target item;
+        item.field = field;
+        item.column = &output;
+        item.resize = &resize_column<Column>;
+        item.parse = &parse_field<Column>;
+        // targets are kept ordered by field, like fields in row
+        std::size_t pos = m_targets.size();
+        while ((pos > 0) && (m_targets[pos - 1].field > field)) {
+            --pos;
+        }
+        m_targets.insert(m_targets.begin() + static_cast<std::ptrdiff_t>(pos), item);
+        return *this;
+    }
+
+    /// Parses rows from [first, last), output columns are resized to number of rows.
+    /// Errors are appended to errors, ordered by row and field.
+    /// threadCount = 0 means std::thread::hardware_concurrency().
+    /// \result Returns number of data rows
+    std::size_t parse(const char *first, const char *last, std::vector<csv_error> &errors,
+            unsigned threadCount = 0) const {
+        const char *data = first;
+        if (m_header) {
+            data = details::csv_find_newline(first, last);
+            if (data != last) {
+                ++data;
+            }
+        }
+        const std::size_t size = static_cast<std::size_t>(last - data);
+        const std::size_t chunkCount = details::parallel_chunk_count(size);
+
+        // the first pass: rows starting in each chunk (after '\n' or at start of data)
+        std::vector<std::size_t> rowStart(chunkCount + 1, 0);
+        details::parallel_for_chunks(size, threadCount,
+                [&](std::size_t chunk, std::size_t offset, std::size_t count) {
+                    // '\n' at position p - 1 starts row at p, the last one does not
+                    rowStart[chunk + 1] = ((offset == 0) ? 1 : 0) + details::csv_count_newlines(
+                            data + ((offset == 0) ? 0 : offset - 1), data + offset + count - 1);
+                });
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            rowStart[chunk + 1] += rowStart[chunk];
+        }
+        const std::size_t rowCount = rowStart[chunkCount];
+        for (std::size_t i = 0; i < m_targets.size(); ++i) {
+            m_targets[i].resize(m_targets[i].column, rowCount);
+        }
+
+        // the second pass: rows of each chunk are converted to its place in columns
+        std::vector<std::vector<csv_error> > chunkErrors(chunkCount);
+        details::parallel_for_chunks(size, threadCount,
+                [&](std::size_t chunk, std::size_t offset, std::size_t count) {
+                    const char *pos = data + offset;
+                    if ((offset != 0) && (pos[-1] != '\n')) {
+                        // the first row starting in this chunk
+                        pos = details::csv_find_newline(pos, last);
+                        if (pos != last) {
+                            ++pos;
+                        }
+                    }
+                    const char *end = data + offset + count;
+                    std::size_t row = rowStart[chunk];
+                    while (pos < end) {
+                        pos = parseRow(pos, last, row, static_cast<std::size_t>(data - first),
+                                data, chunkErrors[chunk]);
+                        ++row;
+                    }
+                });
+
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            errors.insert(errors.end(), chunkErrors[chunk].begin(), chunkErrors[chunk].end());
+        }
+        return rowCount;
+    }
+
+private:
+    struct target {
+        std::size_t field;
+        void *column;
+        void (*resize)(void *column, std::size_t size);
+        std::errc (*parse)(const char *first, const char *last, void *column, std::size_t row);
+    };
+
+    template<class Column>
+    static void resize_column(void *column, std::size_t size) {
+        static_cast<Column *>(column)->resize(size);
+    }
+
+    // value of field is stored in column, zero on error
+    template<class Column>
+    static std::errc parse_field(const char *first, const char *last, void *column,
+            std::size_t row) {
+        typedef typename Column::value_type value_type;
+        value_type value;
+        const from_chars_result res = from_chars(first, last, value);
+        std::errc ec = res.ec;
+        if ((ec == std::errc()) && (res.ptr != last)) {
+            ec = std::errc::invalid_argument;
+        }
+        (*static_cast<Column *>(column))[row] = (ec == std::errc()) ? value : value_type(0);
+        return ec;
+    }
+
+    // converts fields of row starting at first, returns start of the next row
+    const char *parseRow(const char *first, const char *last, std::size_t row,
+            std::size_t dataOffset, const char *data, std::vector<csv_error> &errors) const {
+        const char *pos = first;
+        std::size_t field = 0;
+        std::size_t next = 0; // index of next target
+        bool rowEnd = false;
+        const char *rowEndPos = last; // '\r' or '\n' ending the row, or end of input
+        while ((next < m_targets.size()) && !rowEnd) {
+            const char *fieldEnd = details::csv_find_separator(pos, last, m_delimiter);
+            rowEnd = (fieldEnd == last) || (*fieldEnd == '\n');
+            const char *valueEnd = fieldEnd;
+            if (rowEnd && (valueEnd != pos) && (valueEnd[-1] == '\r')) {
+                --valueEnd;
+            }
+            if (rowEnd) {
+                rowEndPos = valueEnd;
+            }
+            for (; (next < m_targets.size()) && (m_targets[next].field == field); ++next) {
+                const std::errc ec = m_targets[next].parse(pos, valueEnd, m_targets[next].column, row);
+                if (ec != std::errc()) {
+                    addError(errors, row, field, dataOffset + static_cast<std::size_t>(pos - data), ec);
+                }
+            }
+            pos = (fieldEnd == last) ? last : fieldEnd + 1;
+            ++field;
+        }
+
+        // missing fields
+        for (; next < m_targets.size(); ++next) {
+            m_targets[next].parse(rowEndPos, rowEndPos, m_targets[next].column, row);
+            addError(errors, row, m_targets[next].field,
+                    dataOffset + static_cast<std::size_t>(rowEndPos - data), std::errc::invalid_argument);
+        }
+
+        if (!rowEnd) {
+            pos = details::csv_find_newline(pos, last);
+            if (pos != last) {
+                ++pos;
+            }
+        }
+        return pos;
+    }
+
+    static void addError(std::vector<csv_error> &errors, std::size_t row, std::size_t field,
+            std::size_t offset, std::errc ec) {
+        csv_error error;
+        error.row = row;
+        error.field = field;
+        error.offset = offset;
+        error.ec = ec;
+        errors.push_back(error);
+    }
+
+    char m_delimiter;
+    bool m_header;
+    std::vector<target> m_targets;
+};
+
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_CSV_H__
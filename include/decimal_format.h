@@ -0,0 +1,434 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_format.h
+// Purpose:     Reusable locale-aware formatting and parsing of decimal values.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_FORMAT_H__
+#define _DECIMAL_FORMAT_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_format.h
+///
+/// decimal_format keeps separators (taken once from a locale or set explicitly),
+/// digit grouping, sign style, padding and number of fraction digits.
+/// It is built once and then used to format or parse any number of decimal
+/// values of any type without locale lookup and without memory allocation
+/// (character buffer versions, like to_chars / from_chars).
+///
+/// Sample usage:
+///   using namespace dec;
+///   decimal_format fmt(std::locale(""));
+///   fmt.setSignStyle(decimal_format::sign_parentheses).setFractionDigits(2, 2);
+///   char buffer[64];
+///   to_chars_result res = fmt.format(buffer, buffer + sizeof(buffer), amount);
+///   ...
+///   decimal4 value;
+///   from_chars_result parsed = fmt.parse(text, text + length, value);
+
+#include "decimal.h"
+
+#include <climits>
+
+namespace DEC_NAMESPACE {
+
+// ----------------------------------------------------------------------------
+// Class definitions
+// ----------------------------------------------------------------------------
+
+class decimal_format {
+public:
+    enum sign_style {
+        sign_negative,   // -1.00, 1.00
+        sign_always,     // -1.00, +1.00
+        sign_parentheses // (1.00), 1.00
+    };
+
+    enum alignment {
+        align_right,    // fill before text
+        align_left,     // fill after text
+        align_internal  // fill between sign and digits
+    };
+
+    enum {
+        // number of fraction digits equal to precision of formatted value
+        value_precision = -1,
+        // maximum length of grouping pattern, the last group size is repeated
+        max_groups = 8
+    };
+
+    /// '.' as decimal point, no grouping, all fraction digits of value
+    decimal_format() :
+            m_decimalPoint('.'), m_thousandsSep(','), m_groupCount(0),
+            m_signStyle(sign_negative), m_width(0), m_fill(' '), m_align(align_right),
+            m_minFraction(value_precision), m_maxFraction(value_precision) {
+    }
+
+    /// Decimal point, thousands separator and grouping of numpunct<char> from locale
+    explicit decimal_format(const std::locale &loc) :
+            m_decimalPoint('.'), m_thousandsSep(','), m_groupCount(0),
+            m_signStyle(sign_negative), m_width(0), m_fill(' '), m_align(align_right),
+            m_minFraction(value_precision), m_maxFraction(value_precision) {
+        if (std::has_facet<std::numpunct<char> >(loc)) {
+            const std::numpunct<char> &facet = std::use_facet<std::numpunct<char> >(loc);
+            m_decimalPoint = facet.decimal_point();
+            setGrouping(facet.thousands_sep(), facet.grouping());
+        }
+    }
+
+    decimal_format &setDecimalPoint(char value) {
+        m_decimalPoint = value;
+        return *this;
+    }
+
+    char getDecimalPoint() const {
+        return m_decimalPoint;
+    }
+
+    /// Grouping as in std::numpunct::grouping(): sizes of groups starting from
+    /// decimal point, the last one is repeated, empty string disables grouping.
+    decimal_format &setGrouping(char separator, const std::string &grouping = "\3") {
+        m_thousandsSep = separator;
+        m_groupCount = 0;
+        for (std::size_t i = 0; (i < grouping.size()) && (m_groupCount < max_groups); ++i) {
+            if ((grouping[i] <= 0) || (grouping[i] == CHAR_MAX)) {
+                // no more grouping, marked as group of unlimited size
+                m_groups[m_groupCount++] = 0;
+                break;
+            }
+            m_groups[m_groupCount++] = grouping[i];
+        }
+        return *this;
+    }
+
+    char getThousandsSep() const {
+        return m_thousandsSep;
+    }
+
+    bool hasGrouping() const {
+        return (m_groupCount > 0) && (m_groups[0] > 0);
+    }
+
+    decimal_format &setSignStyle(sign_style value) {
+        m_signStyle = value;
+        return *this;
+    }
+
+    sign_style getSignStyle() const {
+        return m_signStyle;
+    }
+
+    /// Minimum length of formatted text, shorter text is padded with fill character
+    decimal_format &setWidth(int width, char fill = ' ', alignment align = align_right) {
+        m_width = (width > 0) ? width : 0;
+        m_fill = fill;
+        m_align = align;
+        return *this;
+    }
+
+    int getWidth() const {
+        return m_width;
+    }
+
+    /// Value is rounded (using its RoundPolicy) to maxDigits fraction digits,
+    /// trailing zeros are removed down to minDigits, missing digits are zeros.
+    /// value_precision means precision of formatted value.
+    decimal_format &setFractionDigits(int minDigits, int maxDigits) {
+        m_minFraction = limitFraction(minDigits);
+        m_maxFraction = limitFraction(maxDigits);
+        if ((m_maxFraction != value_precision) && (m_minFraction > m_maxFraction)) {
+            m_maxFraction = m_minFraction;
+        }
+        return *this;
+    }
+
+    int getMinFractionDigits() const {
+        return m_minFraction;
+    }
+
+    int getMaxFractionDigits() const {
+        return m_maxFraction;
+    }
+
+    /// Writes formatted value to [first, last), output is not null-terminated.
+    /// Returns std::errc::value_too_large (with ptr == last) if output is too small.
+    template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+    to_chars_result format(char *first, char *last,
+            const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &value) const {
+        typedef typename storage_traits<StorageType>::unsigned_type unsigned_type;
+        const StorageType unbiased = value.getUnbiased();
+        const bool negative = unbiased < 0;
+        unsigned_type absValue = storage_utils<RoundPolicy, StorageType>::uabs(unbiased);
+
+        // fraction digits available in value after rounding
+        const int maxFraction = (m_maxFraction == value_precision) ? Prec : m_maxFraction;
+        int fracDigits = Prec;
+        if (maxFraction < Prec) {
+            const unsigned_type divisor = static_cast<unsigned_type>(
+                    storage_traits<StorageType>::pow10(Prec - maxFraction));
+            const unsigned_type remainder = absValue % divisor;
+            absValue /= divisor;
+            if (RoundPolicy::away_from_zero(negative, absValue, remainder, divisor)) {
+                ++absValue;
+            }
+            fracDigits = maxFraction;
+        }
+        const unsigned_type factor = static_cast<unsigned_type>(
+                storage_traits<StorageType>::pow10(fracDigits));
+        unsigned_type before = absValue / factor;
+        unsigned_type after = absValue % factor;
+
+        const int minFraction = (m_minFraction == value_precision) ? Prec : m_minFraction;
+        while ((fracDigits > minFraction) && (after % 10 == 0)) {
+            after /= 10;
+            --fracDigits;
+        }
+        const int zeroDigits = (minFraction > fracDigits) ? minFraction - fracDigits : 0;
+
+        // text without padding is built backwards in local buffer
+        char text[text_size];
+        char *const end = text + text_size;
+        char *pos = end;
+        const bool showNegative = negative && (absValue != 0);
+        if (showNegative && (m_signStyle == sign_parentheses)) {
+            *--pos = ')';
+        }
+        for (int i = 0; i < zeroDigits; ++i) {
+            *--pos = '0';
+        }
+        if (fracDigits > 0) {
+            pos = details::write_digits_backward(pos, after, fracDigits);
+        }
+        if (fracDigits + zeroDigits > 0) {
+            *--pos = m_decimalPoint;
+        }
+        pos = writeInteger(pos, before);
+        char *const digits = pos;
+        if (showNegative) {
+            *--pos = (m_signStyle == sign_parentheses) ? '(' : '-';
+        } else if (m_signStyle == sign_always) {
+            *--pos = '+';
+        }
+
+        const int length = static_cast<int>(end - pos);
+        const int padding = (m_width > length) ? m_width - length : 0;
+        to_chars_result result;
+        if (last - first < length + padding) {
+            result.ptr = last;
+            result.ec = std::errc::value_too_large;
+            return result;
+        }
+
+        char *out = first;
+        if (m_align == align_right) {
+            out = fill(out, padding);
+            out = copy(out, pos, end);
+        } else if (m_align == align_left) {
+            out = copy(out, pos, end);
+            out = fill(out, padding);
+        } else {
+            out = copy(out, pos, digits);
+            out = fill(out, padding);
+            out = copy(out, digits, end);
+        }
+
+        result.ptr = out;
+        result.ec = std::errc();
+        return result;
+    }
+
+    /// Formats value to output string (its capacity is reused)
+    template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+    std::string &format(const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &value,
+            std::string &output) const {
+        char buffer[text_size];
+        const to_chars_result res = format(buffer, buffer + sizeof(buffer), value);
+        if (res.ec == std::errc()) {
+            output.assign(buffer, res.ptr);
+        } else {
+            // text longer than buffer only because of padding
+            output.resize(static_cast<std::size_t>(m_width));
+            const to_chars_result wide = format(&output[0], &output[0] + output.size(), value);
+            output.resize(static_cast<std::size_t>(wide.ptr - &output[0]));
+        }
+        return output;
+    }
+
+    template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+    std::string format(const decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &value) const {
+        std::string result;
+        format(value, result);
+        return result;
+    }
+
+    /// Converts chars from [first, last) to decimal.
+    /// Accepts leading spaces or fill characters, sign ('-', '+' or value in
+    /// parentheses), fill characters after sign, digits with thousands separators (when grouping is used),
+    /// decimal point and fraction digits. Extra fraction digits are rounded
+    /// like in from_chars. On error output is not modified.
+    template<int Prec, class RoundPolicy, class OverflowPolicy, class StorageType>
+    from_chars_result parse(const char *first, const char *last,
+            decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> &output) const {
+        from_chars_result result = { first, std::errc() };
+        const char *pos = first;
+        while ((pos != last) && ((*pos == ' ') || (*pos == '\t') || (*pos == m_fill))) {
+            ++pos;
+        }
+
+        // normalized text for from_chars: optional '-', digits, '.', digits
+        char text[text_size];
+        char *out = text;
+        bool parentheses = false;
+        if (pos != last) {
+            if (*pos == '(') {
+                parentheses = true;
+                *out++ = '-';
+                ++pos;
+            } else if ((*pos == '-') || (*pos == '+')) {
+                *out++ = *pos++;
+            }
+        }
+        // fill characters between sign and digits (align_internal), zeros are digits anyway
+        if ((out != text) && !details::is_digit(m_fill)) {
+            while ((pos != last) && (*pos == m_fill)) {
+                ++pos;
+            }
+        }
+
+        // leading zeros are skipped, the rest must fit in storage
+        const int maxIntDigits = storage_traits<StorageType>::digits10 + 1;
+        const bool grouping = hasGrouping();
+        bool hasDigits = false;
+        bool overflow = false;
+        int intDigits = 0;
+        for (; pos != last; ++pos) {
+            if (details::is_digit(*pos)) {
+                hasDigits = true;
+                if ((intDigits > 0) || (*pos != '0')) {
+                    if (intDigits < maxIntDigits) {
+                        *out++ = *pos;
+                    } else {
+                        overflow = true;
+                    }
+                    ++intDigits;
+                }
+            } else if (!(grouping && hasDigits && (*pos == m_thousandsSep)
+                    && (pos + 1 != last) && details::is_digit(pos[1]))) {
+                break;
+            }
+        }
+        if (hasDigits && (intDigits == 0)) {
+            *out++ = '0';
+        }
+
+        // fraction: digits used by from_chars for rounding, then sticky digit
+        if ((pos != last) && (*pos == m_decimalPoint)) {
+            *out++ = '.';
+            ++pos;
+            int fracDigits = 0;
+            bool sticky = false;
+            for (; (pos != last) && details::is_digit(*pos); ++pos) {
+                hasDigits = true;
+                if (fracDigits < max_fraction_chars) {
+                    *out++ = *pos;
+                    ++fracDigits;
+                } else if (*pos != '0') {
+                    sticky = true;
+                }
+            }
+            if (sticky) {
+                *out++ = '1';
+            }
+        }
+
+        if (!hasDigits || (parentheses && ((pos == last) || (*pos != ')')))) {
+            result.ec = std::errc::invalid_argument;
+            return result;
+        }
+        if (parentheses) {
+            ++pos;
+        }
+        result.ptr = pos;
+        if (overflow) {
+            result.ec = std::errc::result_out_of_range;
+            return result;
+        }
+
+        decimal<Prec, RoundPolicy, OverflowPolicy, StorageType> value;
+        result.ec = from_chars(text, out, value).ec;
+        if (result.ec == std::errc()) {
+            output = value;
+        }
+        return result;
+    }
+
+private:
+    enum {
+        // fraction digits passed to from_chars: precision and 18 digits for rounding
+        max_fraction_chars = 2 * max_decimal_points,
+        // sign or parentheses, 39 digits with separators, point, fraction digits
+        text_size = 2 + 39 * 2 + 1 + 2 * max_decimal_points + 2
+    };
+
+    static int limitFraction(int digits) {
+        if (digits < 0) {
+            return value_precision;
+        }
+        return (digits > max_decimal_points) ? max_decimal_points : digits;
+    }
+
+    // writes digits of value with group separators ending at end
+    template<typename T>
+    char *writeInteger(char *end, T value) const {
+        if (!hasGrouping()) {
+            return details::write_digits_backward(end, value, details::count_digits(value));
+        }
+        int group = 0;
+        int groupSize = (m_groupCount > 0) ? m_groups[0] : 0;
+        int inGroup = 0;
+        do {
+            if ((groupSize > 0) && (inGroup == groupSize)) {
+                *--end = m_thousandsSep;
+                inGroup = 0;
+                if (group + 1 < m_groupCount) {
+                    groupSize = m_groups[++group];
+                }
+            }
+            *--end = static_cast<char>('0' + static_cast<int>(value % 10));
+            value /= 10;
+            ++inGroup;
+        } while (value != 0);
+        return end;
+    }
+
+    char *fill(char *out, int count) const {
+        for (int i = 0; i < count; ++i) {
+            *out++ = m_fill;
+        }
+        return out;
+    }
+
+    static char *copy(char *out, const char *first, const char *last) {
+        while (first != last) {
+            *out++ = *first++;
+        }
+        return out;
+    }
+
+    char m_decimalPoint;
+    char m_thousandsSep;
+    int m_groupCount;
+    char m_groups[max_groups];
+    sign_style m_signStyle;
+    int m_width;
+    char m_fill;
+    alignment m_align;
+    int m_minFraction;
+    int m_maxFraction;
+};
+
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_FORMAT_H__
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_parallel.h
+// Purpose:     Multi-threaded reductions over arrays of decimal values.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_PARALLEL_H__
+#define _DECIMAL_PARALLEL_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_parallel.h
+///
+/// Reductions of large decimal arrays using several threads (requires C++11
+/// and linking with thread library, e.g. -pthread).
+/// Input is divided into chunks of fixed size, which are picked up by worker
+/// threads from a shared counter. Partial results are exact (128-bit or wider
+/// integer sums) and merged in chunk order, so result does not depend on
+/// number of threads.
+/// parallel_format writes text of values to a single buffer, each chunk at
+/// its position calculated from lengths of preceding chunks.
+///
+/// threadCount = 0 means std::thread::hardware_concurrency().
+///
+/// Sample usage:
+///   using namespace dec;
+///   std::vector<decimal2> prices;
+///   std::vector<decimal4> quantities;
+///   ...
+///   decimal2 total;
+///   if (parallel_dot<decimal2, decimal2, decimal4>(prices, quantities, total))
+///       cout << "Total: " << total << endl;
+
+#include "decimal_batch.h"
+
+#include <atomic>
+#include <thread>
+#include <system_error>
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+enum {
+    parallel_chunk_size = 1 << 16 // elements processed by a thread at once
+};
+
+inline std::size_t parallel_chunk_count(std::size_t size) {
+    return (size + parallel_chunk_size - 1) / parallel_chunk_size;
+}
+
+// Calls task(chunkIndex, first, count) for all chunks of [0, size) using up to
+// threadCount threads (including calling one).
+template<class Task>
+void parallel_for_chunks(std::size_t size, unsigned threadCount, const Task &task) {
+    const std::size_t chunkCount = parallel_chunk_count(size);
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount > chunkCount) {
+        threadCount = static_cast<unsigned>(chunkCount);
+    }
+
+    std::atomic<std::size_t> nextChunk(0);
+    const auto worker = [&]() {
+        for (std::size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            const std::size_t first = chunk * parallel_chunk_size;
+            const std::size_t count = (size - first < static_cast<std::size_t>(parallel_chunk_size))
+                    ? size - first : static_cast<std::size_t>(parallel_chunk_size);
+            task(chunk, first, count);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) {
+        try {
+            threads.push_back(std::thread(worker));
+        } catch (const std::system_error &) {
+            break; // remaining chunks are processed by running threads
+        }
+    }
+    worker();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+}
+
+} // namespace details
+
+// ----------------------------------------------------------------------------
+// global functions
+// ----------------------------------------------------------------------------
+
+/// Exact sum of values. Returns false and leaves output unchanged when sum
+/// does not fit in DecimalType.
+template<class DecimalType>
+bool parallel_sum(batch::span<const DecimalType> a, DecimalType &output,
+        unsigned threadCount = 0) {
+    static_assert(batch::details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    typedef decimal_accumulator<DecimalType::decimal_points> accumulator_type;
+    std::vector<accumulator_type> partial(details::parallel_chunk_count(a.size()));
+    details::parallel_for_chunks(a.size(), threadCount,
+            [&](std::size_t chunk, std::size_t first, std::size_t count) {
+                partial[chunk] = batch::accumulate(a.subspan(first, count));
+            });
+
+    accumulator_type total;
+    for (std::size_t i = 0; i < partial.size(); ++i) {
+        total += partial[i];
+    }
+    return total.getAsDecimal(output);
+}
+
+/// Smallest and largest value. Returns false for empty input.
+template<class DecimalType>
+bool parallel_minmax(batch::span<const DecimalType> a, DecimalType &minValue,
+        DecimalType &maxValue, unsigned threadCount = 0) {
+    static_assert(batch::details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    if (a.empty()) {
+        return false;
+    }
+    const std::size_t chunkCount = details::parallel_chunk_count(a.size());
+    std::vector<DecimalType> partialMin(chunkCount);
+    std::vector<DecimalType> partialMax(chunkCount);
+    details::parallel_for_chunks(a.size(), threadCount,
+            [&](std::size_t chunk, std::size_t first, std::size_t count) {
+                const batch::span<const DecimalType> part = a.subspan(first, count);
+                partialMin[chunk] = batch::min(part);
+                partialMax[chunk] = batch::max(part);
+            });
+
+    minValue = batch::min(batch::span<const DecimalType>(partialMin));
+    maxValue = batch::max(batch::span<const DecimalType>(partialMax));
+    return true;
+}
+
+/// Same as batch::format, chunks of values are written in parallel: lengths of
+/// chunks are calculated first, so every chunk is written directly at its
+/// position in output.
+template<class DecimalType>
+to_chars_result parallel_format(batch::span<const DecimalType> a, char *first, char *last,
+        char separator = '\n', batch::span<std::size_t> offsets = batch::span<std::size_t>(),
+        unsigned threadCount = 0) {
+    static_assert(batch::details::int64_storage<DecimalType>::value,
+            "decimal with int64 storage required");
+    to_chars_result result;
+    if (!offsets.empty() && (offsets.size() <= a.size())) {
+        result.ptr = first;
+        result.ec = std::errc::invalid_argument;
+        return result;
+    }
+
+    const std::size_t chunkCount = details::parallel_chunk_count(a.size());
+    std::vector<std::size_t> chunkStart(chunkCount + 1, 0);
+    details::parallel_for_chunks(a.size(), threadCount,
+            [&](std::size_t chunk, std::size_t offset, std::size_t count) {
+                std::size_t length = 0;
+                for (std::size_t i = offset; i < offset + count; ++i) {
+                    length += batch::details::formatted_length(a[i]) + 1;
+                }
+                chunkStart[chunk + 1] = length;
+            });
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        chunkStart[chunk + 1] += chunkStart[chunk];
+    }
+
+    const std::size_t length = chunkStart[chunkCount];
+    if (static_cast<std::size_t>(last - first) < length) {
+        result.ptr = last;
+        result.ec = std::errc::value_too_large;
+        return result;
+    }
+
+    std::size_t *positions = offsets.empty() ? NULL : offsets.data();
+    details::parallel_for_chunks(a.size(), threadCount,
+            [&](std::size_t chunk, std::size_t offset, std::size_t count) {
+                batch::details::format_kernel(a.data() + offset, count, separator,
+                        first + chunkStart[chunk], (positions != NULL) ? positions + offset : NULL,
+                        chunkStart[chunk]);
+            });
+    if (positions != NULL) {
+        positions[a.size()] = length;
+    }
+    result.ptr = first + length;
+    result.ec = std::errc();
+    return result;
+}
+
+#ifdef DEC_HAS_INT128
+/// Sum of a[i] * b[i] calculated exactly and rounded once to precision of
+/// OutDecimalType using its rounding policy. Returns false and leaves output
+/// unchanged when result does not fit in OutDecimalType.
+/// Uses min(a.size(), b.size()) elements.
+template<class OutDecimalType, class DecimalTypeA, class DecimalTypeB>
+bool parallel_dot(batch::span<const DecimalTypeA> a, batch::span<const DecimalTypeB> b,
+        OutDecimalType &output, unsigned threadCount = 0) {
+    static_assert(batch::details::int64_storage<OutDecimalType>::value,
+            "decimal with int64 storage required");
+    static_assert(batch::details::int64_storage<DecimalTypeA>::value,
+            "decimal with int64 storage required");
+    static_assert(batch::details::int64_storage<DecimalTypeB>::value,
+            "decimal with int64 storage required");
+    const std::size_t size = (a.size() < b.size()) ? a.size() : b.size();
+    std::vector<batch::details::product_sum> partial(details::parallel_chunk_count(size));
+    details::parallel_for_chunks(size, threadCount,
+            [&](std::size_t chunk, std::size_t first, std::size_t count) {
+                partial[chunk] = batch::details::dot_kernel(a.data() + first, b.data() + first, count);
+            });
+
+    batch::details::product_sum total;
+    for (std::size_t i = 0; i < partial.size(); ++i) {
+        total.add(partial[i]);
+    }
+    int64 result = 0;
+    if (!total.template get<typename OutDecimalType::round_policy_t>(
+            static_cast<int>(DecimalTypeA::decimal_points)
+                    + static_cast<int>(DecimalTypeB::decimal_points)
+                    - static_cast<int>(OutDecimalType::decimal_points), result)) {
+        return false;
+    }
+    output.setUnbiased(result);
+    return true;
+}
+#endif // DEC_HAS_INT128
+
+} // namespace DEC_NAMESPACE
+#endif // _DECIMAL_PARALLEL_H__
@@ -910,6 +910,420 @@ BOOST_AUTO_TEST_CASE(decimalString)
                 BOOST_CHECK(d == fromString<decimal<4> >(sneg));
         }
 
+template<int Prec>
+std::string to_chars_str(const dec::decimal<Prec> &arg) {
+    char buffer[dec::max_decimal_chars];
+    dec::to_chars_result res = dec::to_chars(buffer, buffer + sizeof(buffer), arg);
+    BOOST_CHECK(res.ec == std::errc());
+    return std::string(buffer, res.ptr);
+}
+
+BOOST_AUTO_TEST_CASE(decimalToChars)
+        {
+                using namespace dec;
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<2>("0")), "0.00");
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<2>("-0.05")), "-0.05");
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<2>("123456.78")), "123456.78");
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<4>("-9.0001")), "-9.0001");
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<0>(-100)), "-100");
+                BOOST_CHECK_EQUAL(to_chars_str(decimal<5>("10.1")), "10.10000");
+
+                decimal<2> d;
+                d.setUnbiased(DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL(to_chars_str(d), "-92233720368547758.08");
+                d.setUnbiased(DEC_MAX_INT64);
+                BOOST_CHECK_EQUAL(to_chars_str(d), "92233720368547758.07");
+                BOOST_CHECK_EQUAL(toString(d), "92233720368547758.07");
+
+                // output buffer too small
+                char small[4];
+                to_chars_result res = to_chars(small, small + sizeof(small), decimal<2>("10.25"));
+                BOOST_CHECK(res.ec == std::errc::value_too_large);
+                BOOST_CHECK(res.ptr == small + sizeof(small));
+                res = to_chars(small, small + sizeof(small), decimal<2>("0.25"));
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK_EQUAL(std::string(small, res.ptr), "0.25");
+        }
+
+template<int Prec, class RoundPolicy>
+dec::decimal<Prec, RoundPolicy> from_chars_dec(const std::string &text, std::errc expectedError = std::errc(),
+        size_t expectedLength = std::string::npos) {
+    dec::decimal<Prec, RoundPolicy> result;
+    dec::from_chars_result res = dec::from_chars(text.data(), text.data() + text.size(), result);
+    BOOST_CHECK_MESSAGE(res.ec == expectedError, "from_chars(" << text << ") error code");
+    if (expectedLength == std::string::npos)
+        expectedLength = text.size();
+    BOOST_CHECK_MESSAGE(res.ptr == text.data() + expectedLength, "from_chars(" << text << ") end position");
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(decimalFromChars)
+        {
+                using namespace dec;
+                typedef def_round_policy def;
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("0")), decimal<2>().pack(0, 0));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("-12.5")), decimal<2>().pack(-12, -50));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("+.5")), decimal<2>().pack(0, 50));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("7.")), decimal<2>(7));
+                BOOST_CHECK_EQUAL((from_chars_dec<4, def>("12345678901234.5678")), decimal<4>().pack(12345678901234, 5678));
+                BOOST_CHECK_EQUAL((from_chars_dec<0, def>("00000000000000000000000000042")), decimal<0>(42));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("1.25x", std::errc(), 4)), decimal<2>().pack(1, 25));
+
+                // rounding of extra digits
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("0.125")), decimal<2>().pack(0, 13));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("-0.125")), decimal<2>().pack(0, -13));
+                BOOST_CHECK_EQUAL((from_chars_dec<2, half_even_round_policy>("0.125").getUnbiased()), 12);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, half_even_round_policy>("0.135").getUnbiased()), 14);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, half_even_round_policy>("0.12500000000000000000000001").getUnbiased()), 13);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, ceiling_round_policy>("0.12000000000000000000000001").getUnbiased()), 13);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, ceiling_round_policy>("-0.129").getUnbiased()), -12);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, floor_round_policy>("-0.121").getUnbiased()), -13);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, null_round_policy>("0.129999").getUnbiased()), 12);
+
+                // limits
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("-92233720368547758.08").getUnbiased()), DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL((from_chars_dec<2, def>("92233720368547758.07").getUnbiased()), DEC_MAX_INT64);
+                from_chars_dec<2, def>("92233720368547758.08", std::errc::result_out_of_range);
+                from_chars_dec<2, def>("92233720368547758.075", std::errc::result_out_of_range);
+                from_chars_dec<0, def>("123456789012345678901234", std::errc::result_out_of_range);
+
+                // errors
+                from_chars_dec<2, def>("", std::errc::invalid_argument, 0);
+                from_chars_dec<2, def>("-", std::errc::invalid_argument, 0);
+                from_chars_dec<2, def>(".", std::errc::invalid_argument, 0);
+                from_chars_dec<2, def>(" 1", std::errc::invalid_argument, 0);
+                from_chars_dec<2, def>("abc", std::errc::invalid_argument, 0);
+
+                // string conversions are based on from_chars
+                BOOST_CHECK_EQUAL(decimal<2>(" \t-1.005"), decimal<2>().pack(-1, -1));
+                BOOST_CHECK_EQUAL(decimal<2>(std::string("abc")), decimal<2>(0));
+                BOOST_CHECK_EQUAL(fromString<decimal<3> >("2.5"), decimal<3>().pack(2, 500));
+        }
+
+#ifdef DEC_HAS_CONSTEXPR14
+BOOST_AUTO_TEST_CASE(decimalConstexpr)
+        {
+                using namespace dec;
+                using namespace dec::literals;
+
+                constexpr decimal2 fee = 1.25_d2;
+                constexpr decimal4 tick = "0.0001"_d4;
+                constexpr decimal2 rate = decimal_cast<2>("3.33");
+                constexpr decimal<6, half_even_round_policy> small =
+                        decimal_cast<6, half_even_round_policy>("0.0000125");
+
+                static_assert(DecimalFactor<4>::value == 10000, "DecimalFactor");
+                static_assert(dec_utils<def_round_policy>::pow10(5) == 100000, "pow10");
+                static_assert(fee.getUnbiased() == 125, "numeric literal");
+                static_assert(tick.getUnbiased() == 1, "string literal");
+                static_assert(small.getUnbiased() == 12, "rounding in literal");
+                static_assert(fee + fee > fee, "addition");
+                static_assert((fee - rate).getUnbiased() == -208, "subtraction");
+                static_assert((fee * decimal2(3)).getUnbiased() == 375, "multiplication");
+                static_assert((rate / decimal2(3)).getUnbiased() == 111, "division");
+                static_assert((rate / 2).getUnbiased() == 167, "division by int");
+                static_assert(decimal_cast<2>(7) == decimal2(7), "decimal_cast");
+                static_assert((-fee).abs() == fee, "abs");
+
+                BOOST_CHECK_EQUAL(1.25_d2, decimal2("1.25"));
+                BOOST_CHECK_EQUAL("-12.5"_d6, decimal6("-12.5"));
+                BOOST_CHECK_EQUAL(0.00015_d4, decimal4("0.0002"));
+        }
+#endif
+
+#ifndef DEC_NO_CPP11
+BOOST_AUTO_TEST_CASE(decimalInvalidLiteral)
+        {
+                using namespace dec;
+                using namespace dec::literals;
+
+                // not a constant expression, so invalid literals throw instead of failing compilation
+                BOOST_CHECK_THROW(1e5_d2, std::invalid_argument);
+                BOOST_CHECK_THROW(1e-4_d4, std::invalid_argument);
+                BOOST_CHECK_THROW(0x10_d2, std::invalid_argument);
+                BOOST_CHECK_THROW(99999999999999999999_d2, std::invalid_argument);
+                BOOST_CHECK_THROW("1'000.25"_d2, std::invalid_argument);
+                BOOST_CHECK_THROW("12.5x"_d6, std::invalid_argument);
+                BOOST_CHECK_THROW(""_d4, std::invalid_argument);
+                BOOST_CHECK_EQUAL(1000.25_d2, decimal2("1000.25"));
+        }
+#endif
+
+BOOST_AUTO_TEST_CASE(decimalTriviallyCopyable)
+        {
+                using namespace dec;
+                typedef decimal<4, half_even_round_policy> dec_type;
+                BOOST_CHECK(std::is_trivially_copyable<dec_type>::value);
+                BOOST_CHECK(std::is_standard_layout<dec_type>::value);
+
+                dec_type src[3] = { dec_type("1.5"), dec_type("-2.25"), dec_type("0.0001") };
+                dec_type dst[3];
+                std::memcpy(dst, src, sizeof(src));
+                for (int i = 0; i < 3; ++i)
+                    BOOST_CHECK_EQUAL(dst[i], src[i]);
+        }
+
+BOOST_AUTO_TEST_CASE(decimalAccumulator)
+        {
+                using namespace dec;
+                decimal6 big;
+                big.setUnbiased(DEC_MAX_INT64 / 3);
+                decimal_accumulator<6> total;
+                for (int i = 0; i < 1000; ++i)
+                    total += big;
+                BOOST_CHECK_EQUAL(total.sign(), 1);
+                BOOST_CHECK_EQUAL(total.getUnbiasedHigh(), 166);
+
+                decimal6 result("1.5");
+                BOOST_CHECK(!total.getAsDecimal(result));
+                BOOST_CHECK_EQUAL(result, decimal6("1.5"));
+                decimal<0> units;
+                BOOST_CHECK(total.getAsDecimal(units));
+                BOOST_CHECK_EQUAL(units.getUnbiased(), (DEC_MAX_INT64 / 3) / 1000 + 1);
+
+                // back in range after subtraction
+                for (int i = 0; i < 999; ++i)
+                    total -= big;
+                BOOST_CHECK(total.getAsDecimal(result));
+                BOOST_CHECK_EQUAL(result, big);
+                total -= big;
+                total -= big;
+                BOOST_CHECK_EQUAL(total.sign(), -1);
+                BOOST_CHECK(total.getAsDecimal(result));
+                BOOST_CHECK_EQUAL(result, -big);
+
+                // extreme values
+                decimal_accumulator<2> limits;
+                limits.addUnbiased(DEC_MIN_INT64);
+                decimal2 d2;
+                BOOST_CHECK(limits.getAsDecimal(d2));
+                BOOST_CHECK_EQUAL(d2.getUnbiased(), DEC_MIN_INT64);
+                limits.addUnbiased(-1);
+                BOOST_CHECK(!limits.getAsDecimal(d2));
+                limits += decimal_accumulator<2>(decimal2(1)) - decimal_accumulator<2>(decimal2("0.99"));
+                BOOST_CHECK(limits.getAsDecimal(d2));
+                BOOST_CHECK_EQUAL(d2.getUnbiased(), DEC_MIN_INT64);
+                BOOST_CHECK(limits == decimal_accumulator<2>(d2));
+                limits -= decimal_accumulator<2>(d2);
+                BOOST_CHECK_EQUAL(limits.sign(), 0);
+
+                // conversion to higher precision
+                decimal_accumulator<2> cents;
+                cents += decimal2("-12.34");
+                decimal6 d6;
+                BOOST_CHECK(cents.getAsDecimal(d6));
+                BOOST_CHECK_EQUAL(d6, decimal6("-12.34"));
+                cents.addUnbiased(-DEC_MAX_INT64 / 1000);
+                BOOST_CHECK(!cents.getAsDecimal(d6));
+
+                // rounding to lower precision
+                decimal_accumulator<3> ties;
+                ties += decimal<3>("-0.125");
+                decimal<2, half_even_round_policy> even;
+                decimal<2, half_up_round_policy> up;
+                decimal<2, floor_round_policy> floor;
+                BOOST_CHECK(ties.getAsDecimal(even) && ties.getAsDecimal(up) && ties.getAsDecimal(floor));
+                BOOST_CHECK_EQUAL(even.getUnbiased(), -12);
+                BOOST_CHECK_EQUAL(up.getUnbiased(), -12);
+                BOOST_CHECK_EQUAL(floor.getUnbiased(), -13);
+        }
+
+BOOST_AUTO_TEST_CASE(decimalOverflowPolicy)
+        {
+                using namespace dec;
+                typedef decimal<2, def_round_policy, throwing_overflow_policy> dec_throw;
+                typedef decimal<2, def_round_policy, saturating_overflow_policy> dec_sat;
+                typedef decimal<2, def_round_policy, flagged_overflow_policy> dec_flag;
+                const int64 big = DEC_MAX_INT64 / 2 + 1;
+
+                // checked types give the same results when there is no overflow
+                BOOST_CHECK_EQUAL(dec_throw("1.25") * dec_throw("-3.5"), dec_throw("-4.38"));
+                BOOST_CHECK_EQUAL(dec_throw("1.25") / dec_throw("-3"), dec_throw("-0.42"));
+                BOOST_CHECK_EQUAL(dec_throw("1.25") + dec_throw("-3") - dec_throw("0.5"), dec_throw("-2.25"));
+                BOOST_CHECK_EQUAL(dec_throw("-1.25").abs(), dec_throw("1.25"));
+                BOOST_CHECK_EQUAL(dec_sat(7) * static_cast<int64>(-3), dec_sat(-21));
+
+                dec_throw t1;
+                t1.setUnbiased(big);
+                BOOST_CHECK_THROW(t1 + t1, std::overflow_error);
+                BOOST_CHECK_THROW(t1 - (-t1), std::overflow_error);
+                BOOST_CHECK_THROW(t1 * 2, std::overflow_error);
+                BOOST_CHECK_THROW(t1 * dec_throw("2.5"), std::overflow_error);
+                BOOST_CHECK_THROW(t1 / dec_throw("0.5"), std::overflow_error);
+                BOOST_CHECK_THROW(dec_throw(DEC_MAX_INT64 / 10), std::overflow_error);
+                BOOST_CHECK_THROW(t1.setWithExponent(1, 20), std::overflow_error);
+                BOOST_CHECK_THROW(t1.setWithExponent(big, 1), std::overflow_error);
+                BOOST_CHECK_NO_THROW(t1 + (-t1));
+                t1.setUnbiased(DEC_MIN_INT64);
+                BOOST_CHECK_THROW(-t1, std::overflow_error);
+                BOOST_CHECK_THROW(t1.abs(), std::overflow_error);
+                BOOST_CHECK_THROW(t1 / static_cast<int64>(-1), std::overflow_error);
+                BOOST_CHECK_THROW(t1 -= dec_throw("0.01"), std::overflow_error);
+
+                dec_sat s1;
+                s1.setUnbiased(big);
+                BOOST_CHECK_EQUAL((s1 + s1).getUnbiased(), DEC_MAX_INT64);
+                BOOST_CHECK_EQUAL((-s1 - s1 - s1).getUnbiased(), DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL((s1 * static_cast<int64>(-3)).getUnbiased(), DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL((s1 * dec_sat("-0.5")).getUnbiased(), -(big / 2));
+                BOOST_CHECK_EQUAL((s1 / dec_sat("-0.01")).getUnbiased(), DEC_MIN_INT64);
+                s1.setUnbiased(DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL((-s1).getUnbiased(), DEC_MAX_INT64);
+                s1.setWithExponent(-3, 30);
+                BOOST_CHECK_EQUAL(s1.getUnbiased(), DEC_MIN_INT64);
+
+                flagged_overflow_policy::clear();
+                dec_flag f1("12.5");
+                f1 *= dec_flag(3);
+                f1 -= dec_flag("100");
+                BOOST_CHECK(!flagged_overflow_policy::test());
+                f1.setUnbiased(big);
+                f1 += f1;
+                BOOST_CHECK(flagged_overflow_policy::test());
+                BOOST_CHECK_EQUAL(f1.getUnbiased(), DEC_MIN_INT64); // wrapped result
+                flagged_overflow_policy::clear();
+                BOOST_CHECK(!flagged_overflow_policy::test());
+                f1.setUnbiased(big);
+                f1 *= dec_flag(4);
+                BOOST_CHECK(flagged_overflow_policy::test());
+                BOOST_CHECK_EQUAL(f1.getUnbiased(), 0); // low 64 bits of 2^65
+                flagged_overflow_policy::clear();
+
+                // floating point values out of range
+                const double inf = std::numeric_limits<double>::infinity();
+                BOOST_CHECK_THROW(dec_throw(1e20), std::overflow_error);
+                BOOST_CHECK_THROW(dec_throw(inf).getUnbiased(), std::overflow_error);
+                BOOST_CHECK_THROW(dec_throw(std::numeric_limits<double>::quiet_NaN()), std::overflow_error);
+                BOOST_CHECK_THROW(dec_throw(static_cast<xdouble>(-1e20)), std::overflow_error);
+                BOOST_CHECK_THROW(t1 = -inf, std::overflow_error);
+                BOOST_CHECK_EQUAL(dec_throw(-9.2e16).getUnbiased(), -9200000000000000000);
+                BOOST_CHECK_EQUAL(dec_sat(1e20).getUnbiased(), DEC_MAX_INT64);
+                BOOST_CHECK_EQUAL(dec_sat(-1e300).getUnbiased(), DEC_MIN_INT64);
+                BOOST_CHECK_EQUAL(dec_sat(inf).getUnbiased(), DEC_MAX_INT64);
+                BOOST_CHECK_EQUAL(dec_sat(static_cast<xdouble>(1e20)).getUnbiased(), DEC_MAX_INT64);
+                f1 = 1e20;
+                BOOST_CHECK(flagged_overflow_policy::test());
+                flagged_overflow_policy::clear();
+                f1 = 1e15;
+                BOOST_CHECK(!flagged_overflow_policy::test());
+
+                BOOST_CHECK((std::is_same<decimal2::overflow_policy_t, unchecked_overflow_policy>::value));
+
+#ifdef DEC_HAS_CONSTEXPR14
+                static_assert((dec_sat(DEC_MAX_INT64 / 100) + dec_sat(1)).getUnbiased() == DEC_MAX_INT64,
+                        "saturating addition has to be constexpr");
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalStorage32)
+        {
+                using namespace dec;
+                typedef decimal32<2> dec2;
+                typedef decimal32<4, half_even_round_policy> dec4_even;
+                typedef decimal32<2, def_round_policy, throwing_overflow_policy> dec2_throw;
+                typedef decimal32<2, def_round_policy, saturating_overflow_policy> dec2_sat;
+
+                BOOST_CHECK_EQUAL(sizeof(dec2), sizeof(int32));
+                BOOST_CHECK_EQUAL(toString(dec2("21474836.47")), "21474836.47");
+                BOOST_CHECK_EQUAL(toString(dec2("-21474836.48")), "-21474836.48");
+                dec2 p1;
+                BOOST_CHECK(from_chars("21474836.48", "21474836.48" + 11, p1).ec
+                        == std::errc::result_out_of_range);
+                BOOST_CHECK(from_chars("0.125", "0.125" + 5, p1).ec == std::errc());
+                BOOST_CHECK_EQUAL(p1, dec2("0.13"));
+
+                std::ostringstream out;
+                out << dec2("-1234.5");
+                BOOST_CHECK_EQUAL(out.str(), "-1234.50");
+                std::istringstream in("1234.565");
+                in >> p1;
+                BOOST_CHECK_EQUAL(p1, dec2("1234.57"));
+
+                // intermediate values are 64-bit
+                BOOST_CHECK_EQUAL(dec2("20000000") * dec2("0.5"), dec2("10000000"));
+                BOOST_CHECK_EQUAL(dec2("20000000") / dec2("4"), dec2("5000000"));
+                BOOST_CHECK_EQUAL(dec4_even("0.0005") * dec4_even("0.5"), dec4_even("0.0002"));
+                BOOST_CHECK_EQUAL(dec4_even(1) / dec4_even(3), dec4_even("0.3333"));
+                BOOST_CHECK_EQUAL(dec2(12.345), dec2("12.35"));
+
+                // narrowing is checked by overflow policy
+                BOOST_CHECK_THROW(dec2_throw("20000000") * dec2_throw(2), std::overflow_error);
+                BOOST_CHECK_THROW(dec2_throw("20000000") + dec2_throw("20000000"), std::overflow_error);
+                BOOST_CHECK_THROW(dec2_throw(static_cast<int64>(30000000)), std::overflow_error);
+                BOOST_CHECK_THROW(dec2_throw(1) * static_cast<int64>(5000000000LL), std::overflow_error);
+                BOOST_CHECK_EQUAL((dec2_sat("20000000") / dec2_sat("0.5")).getUnbiased(), INT32_MAX);
+
+                // decimal_cast with output type
+                const decimal<6> amount("12345.678951");
+                BOOST_CHECK_EQUAL(decimal_cast<dec2>(amount), dec2("12345.68"));
+                BOOST_CHECK_EQUAL(decimal_cast<dec4_even>(dec2("-12.5")), dec4_even("-12.5"));
+                BOOST_CHECK_EQUAL(decimal_cast<decimal<6> >(dec2("-12.5")), decimal<6>("-12.5"));
+                BOOST_CHECK_EQUAL(decimal_cast<2>(dec2("-12.5")), decimal2("-12.5"));
+                BOOST_CHECK_EQUAL(decimal_cast<dec2>("3.14159"), dec2("3.14"));
+                BOOST_CHECK_EQUAL(decimal_cast<dec2>(7), dec2(7));
+                BOOST_CHECK_THROW(decimal_cast<dec2_throw>(decimal<6>("30000000")), std::overflow_error);
+                BOOST_CHECK_EQUAL(decimal_cast<dec2_sat>(decimal<6>("-30000000")).getUnbiased(), INT32_MIN);
+                BOOST_CHECK_EQUAL(decimal_cast<dec2_sat>(decimal<0>("-30000000")).getUnbiased(), INT32_MIN);
+#ifdef DEC_HAS_INT128
+                BOOST_CHECK_EQUAL(decimal_cast<dec2>(decimal128<30>("-12.345")), dec2("-12.35"));
+                BOOST_CHECK_EQUAL(toString(decimal_cast<decimal128<30> >(dec2("-12.35"))),
+                        "-12.350000000000000000000000000000");
+#endif
+        }
+
+#ifdef DEC_HAS_INT128
+BOOST_AUTO_TEST_CASE(decimalStorage128)
+        {
+                using namespace dec;
+                typedef decimal128<18> dec18;
+                typedef decimal128<8, half_even_round_policy> dec8_even;
+
+                BOOST_CHECK_EQUAL(sizeof(dec18), sizeof(int128));
+                BOOST_CHECK((std::is_same<dec18::raw_data_t, int128>::value));
+                BOOST_CHECK(dec18::getPrecFactor() == static_cast<int128>(1000000000000000000LL));
+                BOOST_CHECK(storage_traits<int128>::pow10(38) / storage_traits<int128>::pow10(19)
+                        == static_cast<int128>(10000000000000000000ULL));
+
+                // I/O with more than 18 digits
+                const dec18 a("1234567890.123456789012345678");
+                const dec18 b("98765.432109876543210987");
+                BOOST_CHECK_EQUAL(toString(a), "1234567890.123456789012345678");
+                BOOST_CHECK_EQUAL(toString(decimal128<0>("-170141183460469231731687303715884105728")),
+                        "-170141183460469231731687303715884105728");
+                BOOST_CHECK_EQUAL(toString(decimal128<0>("170141183460469231731687303715884105728")), "0");
+                std::ostringstream out;
+                out << -a;
+                BOOST_CHECK_EQUAL(out.str(), "-1234567890.123456789012345678");
+                dec18 c;
+                std::istringstream in("-98765.432109876543210987");
+                in >> c;
+                BOOST_CHECK_EQUAL(c, -b);
+
+                // products wider than 128 bits, rounded once
+                BOOST_CHECK_EQUAL(toString(a * a), "1524157875323883675.049535154031397677");
+                BOOST_CHECK_EQUAL(toString(a / b), "12499.999886093750001424");
+                BOOST_CHECK_EQUAL(toString(decimal128<18, floor_round_policy>(-a.getUnbiased(),
+                        dec18::getPrecFactor()) * decimal128<18, floor_round_policy>(a.getUnbiased(),
+                        dec18::getPrecFactor())), "-1524157875323883675.049535154031397677");
+                BOOST_CHECK_EQUAL(dec8_even(1) / dec8_even(3), dec8_even("0.33333333"));
+                BOOST_CHECK_EQUAL(dec8_even("0.00000005") / 2, dec8_even("0.00000002"));
+                BOOST_CHECK_EQUAL(dec8_even("0.00000015") * dec8_even("0.5"), dec8_even("0.00000008"));
+                BOOST_CHECK(dec8_even("2.5").getAsInteger() == 2);
+                BOOST_CHECK_EQUAL(dec8_even("98765432109876543210.5") * 4 - dec8_even(2),
+                        dec8_even("395061728439506172840"));
+
+                decimal128<2, def_round_policy, saturating_overflow_policy> s1;
+                s1.setWithExponent(2, 36);
+                BOOST_CHECK(s1.getUnbiased() == storage_traits<int128>::max_value());
+                BOOST_CHECK_THROW((decimal128<2, def_round_policy, throwing_overflow_policy>(
+                        "100000000000000000000000000000000000") * 1000), std::overflow_error);
+
+                BOOST_CHECK_CLOSE(dec8_even("12345.678").getAsDouble(), 12345.678, 1e-9);
+                BOOST_CHECK_EQUAL(dec8_even(12345.678), dec8_even("12345.678"));
+                BOOST_CHECK_EQUAL(dec8_even(-0.125), dec8_even("-0.125"));
+        }
+#endif
+
 BOOST_AUTO_TEST_CASE(decimalSign)
         {
                 dec::decimal<4> d(-4.1234);
@@ -983,9 +1397,417 @@ BOOST_AUTO_TEST_CASE(multDiv)
 
                         // test step 5 - overflow after gcd
                         tester.test_md(438241312999, 3681227029158+222121, 876482625990, 1840613625656);
+
+                        // result out of range: low 64 bits of truncated quotient with sign
+                        tester.test_md(DEC_MAX_INT64, 4, 2, -2);
+                        tester.test_md(DEC_MAX_INT64, -4, 2, 2);
+                        tester.test_md(DEC_MAX_INT64, DEC_MAX_INT64, 1, 1);
+                        tester.test_md(DEC_MIN_INT64, DEC_MIN_INT64, -3, DEC_MIN_INT64 / 3 * 2 - 1);
                 }
         }
 
+template<class RoundPolicy>
+void test_decimal_divider(const std::string &name) {
+    using namespace dec;
+    typedef decimal<4, RoundPolicy> dec4;
+    const char *divisors[] = { "1", "-1", "3", "-7", "0.0003", "-0.0001", "0.5",
+            "12345.6789", "-98765.4321", "922337203685477.5807" };
+    const int64 values[] = { 0, 1, -1, 5, -5, 15, 25, -35, 12345678, -99999999999,
+            DEC_MAX_INT64 / 3, DEC_MIN_INT64 / 7, DEC_MAX_INT64, DEC_MIN_INT64 + 1 };
+    const int64 intDivisors[] = { 1, -1, 2, 3, -7, 10, -10000, 1099511627777 };
+
+    for (size_t i = 0; i < sizeof(divisors) / sizeof(divisors[0]); ++i) {
+        const dec4 divisor(divisors[i]);
+        const decimal_divider<4, RoundPolicy> divider(divisor);
+        for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+            dec4 value;
+            value.setUnbiased(values[j]);
+            int64 wrapped = 0;
+            if (dec_utils<RoundPolicy>::multDivOverflow(values[j], dec4::getPrecFactor(),
+                    divisor.getUnbiased(), wrapped)) {
+                // quotient out of range: low 64 bits of truncated quotient as in operator/
+                BOOST_CHECK_EQUAL((value / divider).getUnbiased(), wrapped);
+                continue;
+            }
+            const dec4 expected = value / divisor;
+            BOOST_CHECK_MESSAGE((value / divider) == expected, "decimal_divider<" << name << ">: "
+                    << value << " / " << divisor << " is " << (value / divider) << ", expecting: " << expected);
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(intDivisors) / sizeof(intDivisors[0]); ++i) {
+        const decimal_divider<4, RoundPolicy> divider(intDivisors[i]);
+        for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+            dec4 value;
+            value.setUnbiased(values[j]);
+            int64 wrapped = 0;
+            if (dec_utils<RoundPolicy>::multDivOverflow(values[j], dec4::getPrecFactor(),
+                    dec4(intDivisors[i]).getUnbiased(), wrapped)) {
+                BOOST_CHECK_EQUAL(divider.divide(value).getUnbiased(), wrapped);
+                continue;
+            }
+            const dec4 expected = value / dec4(intDivisors[i]);
+            BOOST_CHECK_MESSAGE(divider.divide(value) == expected, "decimal_divider<" << name << ">: "
+                    << value << " / " << intDivisors[i] << " is " << divider.divide(value)
+                    << ", expecting: " << expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalDivider)
+        {
+                using namespace dec;
+                test_decimal_divider<def_round_policy>("default");
+                test_decimal_divider<null_round_policy>("null");
+                test_decimal_divider<half_down_round_policy>("half_down");
+                test_decimal_divider<half_up_round_policy>("half_up");
+                test_decimal_divider<half_even_round_policy>("half_even");
+                test_decimal_divider<ceiling_round_policy>("ceiling");
+                test_decimal_divider<floor_round_policy>("floor");
+                test_decimal_divider<round_down_round_policy>("round_down");
+                test_decimal_divider<round_up_round_policy>("round_up");
+
+                const decimal_divider<2> byRate(decimal2("1.08"));
+                BOOST_CHECK_EQUAL(decimal2("100") / byRate, decimal2("92.59"));
+                BOOST_CHECK_EQUAL(byRate.divideUnbiased(-10000), -9259);
+        }
+
+template<class RoundPolicy, int N>
+void test_div_rounded_pow10(const std::string &name) {
+    using namespace dec;
+    typedef dec_utils<RoundPolicy> utils;
+    const int64 values[] = { 0, 1, -1, 4, -4, 5, -5, 6, -6, 15, -15, 25, -25, 35, -35,
+            12345678, -12345678, 1500000000, -2500000000, DEC_MAX_INT64 / 3, DEC_MIN_INT64 / 7,
+            DEC_MAX_INT64, DEC_MIN_INT64 + 1, DEC_MIN_INT64 };
+    const uint64 divisor = static_cast<uint64>(utils::pow10(N));
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        const uint64 absValue = utils::uabs(values[i]);
+        int64 expected = 0;
+        utils::roundQuotient(values[i] < 0, absValue / divisor, absValue % divisor, divisor,
+                expected);
+        int64 result = 0;
+        BOOST_CHECK(utils::template div_rounded_pow10<N>(result, values[i]));
+        BOOST_CHECK_MESSAGE(result == expected, "div_rounded_pow10<" << N << "> for " << name
+                << ": " << values[i] << " gives " << result << ", expecting: " << expected);
+    }
+}
+
+template<class RoundPolicy>
+void test_div_rounded_pow10_all(const std::string &name) {
+    test_div_rounded_pow10<RoundPolicy, 0>(name);
+    test_div_rounded_pow10<RoundPolicy, 1>(name);
+    test_div_rounded_pow10<RoundPolicy, 2>(name);
+    test_div_rounded_pow10<RoundPolicy, 4>(name);
+    test_div_rounded_pow10<RoundPolicy, 9>(name);
+    test_div_rounded_pow10<RoundPolicy, 18>(name);
+}
+
+BOOST_AUTO_TEST_CASE(decimalDivRoundedPow10)
+        {
+                using namespace dec;
+                test_div_rounded_pow10_all<def_round_policy>("default");
+                test_div_rounded_pow10_all<null_round_policy>("null");
+                test_div_rounded_pow10_all<half_down_round_policy>("half_down");
+                test_div_rounded_pow10_all<half_up_round_policy>("half_up");
+                test_div_rounded_pow10_all<half_even_round_policy>("half_even");
+                test_div_rounded_pow10_all<ceiling_round_policy>("ceiling");
+                test_div_rounded_pow10_all<floor_round_policy>("floor");
+                test_div_rounded_pow10_all<round_down_round_policy>("round_down");
+                test_div_rounded_pow10_all<round_up_round_policy>("round_up");
+
+                int64 result = 0;
+                dec_utils<half_even_round_policy>::div_rounded_pow10<1>(result, -25);
+                BOOST_CHECK_EQUAL(result, -2);
+                dec_utils<def_round_policy>::div_rounded_pow10<1>(result, -25);
+                BOOST_CHECK_EQUAL(result, -3);
+                dec_utils<ceiling_round_policy>::div_rounded_pow10<2>(result, -150);
+                BOOST_CHECK_EQUAL(result, -1);
+                dec_utils<floor_round_policy>::div_rounded_pow10<2>(result, -150);
+                BOOST_CHECK_EQUAL(result, -2);
+
+                // getAsInteger, rescaling of mixed precision values and decimal_cast
+                typedef decimal<2, half_even_round_policy> dec2_even;
+                BOOST_CHECK_EQUAL(dec2_even("-3.50").getAsInteger(), -4);
+                BOOST_CHECK_EQUAL(dec2_even("-2.50").getAsInteger(), -2);
+                typedef decimal<2, floor_round_policy> dec2_floor;
+                BOOST_CHECK_EQUAL(dec2_floor("-2.01").getAsInteger(), -3);
+                BOOST_CHECK_EQUAL(decimal2("-92233720368547758.08").getAsInteger(),
+                        -92233720368547758);
+                BOOST_CHECK_EQUAL(decimal32<3>("-2147483.648").getAsInteger(), -2147484);
+                BOOST_CHECK_EQUAL(decimal_cast<dec2_even>(decimal4("-1.0050")), dec2_even("-1.00"));
+                BOOST_CHECK(decimal_cast<decimal32<1> >(decimal4("-7.2550")) == decimal32<1>("-7.3"));
+#if DEC_TYPE_LEVEL > 1
+                decimal2 a("1.00");
+                a += decimal4("-0.0050");
+                BOOST_CHECK_EQUAL(a, decimal2("0.99"));
+                a = decimal4("-0.0050");
+                BOOST_CHECK_EQUAL(a, decimal2("-0.01"));
+#endif
+        }
+
+// quotient is rounded by its own sign, the same for division by decimal, by integer and
+// for RoundPolicy::div_rounded
+template<class RoundPolicy>
+void test_negative_divisor(const std::string &name) {
+    using namespace dec;
+    typedef decimal<2, RoundPolicy> dec2;
+    typedef dec_utils<RoundPolicy> utils;
+    const int64 values[] = { 100, -100, 5, -5, 15, -15, 25, -25, 150, -150, 1, -1 };
+    const int64 divisors[] = { 2, -2, 3, -3, 4, -4, 7, -7 };
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        for (size_t j = 0; j < sizeof(divisors) / sizeof(divisors[0]); ++j) {
+            const uint64 absValue = utils::uabs(values[i]);
+            const uint64 absDivisor = utils::uabs(divisors[j]);
+            int64 expected = 0;
+            utils::roundQuotient((values[i] < 0) != (divisors[j] < 0), absValue / absDivisor,
+                    absValue % absDivisor, absDivisor, expected);
+
+            dec2 value;
+            value.setUnbiased(values[i]);
+            int64 result = 0;
+            BOOST_CHECK(RoundPolicy::div_rounded(result, values[i], divisors[j]));
+            BOOST_CHECK_MESSAGE(result == expected, "div_rounded for " << name << ": " << values[i]
+                    << " / " << divisors[j] << " gives " << result << ", expecting: " << expected);
+            BOOST_CHECK_MESSAGE((value / divisors[j]).getUnbiased() == expected, name << ": " << value
+                    << " / " << divisors[j] << " gives " << (value / divisors[j]));
+            BOOST_CHECK_MESSAGE((value / dec2(divisors[j])).getUnbiased() == expected, name << ": "
+                    << value << " / decimal " << divisors[j] << " gives " << (value / dec2(divisors[j])));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalNegativeDivisor)
+        {
+                using namespace dec;
+                test_negative_divisor<def_round_policy>("default");
+                test_negative_divisor<null_round_policy>("null");
+                test_negative_divisor<half_down_round_policy>("half_down");
+                test_negative_divisor<half_up_round_policy>("half_up");
+                test_negative_divisor<half_even_round_policy>("half_even");
+                test_negative_divisor<ceiling_round_policy>("ceiling");
+                test_negative_divisor<floor_round_policy>("floor");
+                test_negative_divisor<round_down_round_policy>("round_down");
+                test_negative_divisor<round_up_round_policy>("round_up");
+
+                typedef decimal<2, ceiling_round_policy> dec2_ceiling;
+                BOOST_CHECK_EQUAL(dec2_ceiling("1.00") / dec2_ceiling(-3), dec2_ceiling("-0.33"));
+                BOOST_CHECK_EQUAL(dec2_ceiling("1.00") / -3, dec2_ceiling("-0.33"));
+                typedef decimal<2, floor_round_policy> dec2_floor;
+                BOOST_CHECK_EQUAL(dec2_floor("1.00") / dec2_floor(-3), dec2_floor("-0.34"));
+                BOOST_CHECK_EQUAL(dec2_floor("-1.00") / -3, dec2_floor("0.33"));
+                typedef decimal<2, half_even_round_policy> dec2_even;
+                BOOST_CHECK_EQUAL(dec2_even("1.00") / 3, dec2_even("0.33"));
+                BOOST_CHECK_EQUAL(dec2_even("0.05") / -2, dec2_even("-0.02"));
+                BOOST_CHECK_EQUAL(dec2_even("0.07") / dec2_even(-2), dec2_even("-0.04"));
+                typedef decimal<2, half_up_round_policy> dec2_up;
+                BOOST_CHECK_EQUAL(dec2_up("0.05") / -2, dec2_up("-0.02"));
+                typedef decimal<2, half_down_round_policy> dec2_down;
+                BOOST_CHECK_EQUAL(dec2_down("0.05") / dec2_down(-2), dec2_down("-0.03"));
+        }
+
+BOOST_AUTO_TEST_CASE(decimalExactRescale)
+        {
+                using namespace dec;
+                typedef decimal<2, half_even_round_policy> dec2_even;
+                typedef decimal<0, half_even_round_policy> dec0_even;
+
+                // values above 2^53 are not representable in double
+                const decimal<4> up(int64(9007199254740993), int64(10));
+                BOOST_CHECK_EQUAL(up.getUnbiased(), 9007199254740993000);
+                const decimal<2> down(int64(900719925474099351), int64(10000));
+                BOOST_CHECK_EQUAL(down.getUnbiased(), 9007199254740994);
+                const dec2_even tie(int64(-900719925474099350), int64(10000));
+                BOOST_CHECK_EQUAL(tie.getUnbiased(), -9007199254740994);
+                const dec2_even tie2(int64(-900719925474099250), int64(10000));
+                BOOST_CHECK_EQUAL(tie2.getUnbiased(), -9007199254740992);
+
+                BOOST_CHECK_EQUAL(decimal_cast<2>(decimal6("1.005000")), decimal2("1.01"));
+                BOOST_CHECK_EQUAL(decimal_cast<2>(decimal6("-1.004999")), decimal2("-1.00"));
+                BOOST_CHECK_EQUAL(decimal_cast<6>(decimal2("-92233720368.54")),
+                        decimal6("-92233720368.540000"));
+                decimal6 large;
+                large.setUnbiased(9007199254740995005);
+                BOOST_CHECK_EQUAL(decimal_cast<2>(large), decimal2("9007199254741.00"));
+                large.setUnbiased(-9007199254740994999);
+                BOOST_CHECK_EQUAL(decimal_cast<2>(large), decimal2("-9007199254740.99"));
+
+                decimal2 packed;
+                BOOST_CHECK_EQUAL(packed.pack_rounded<4>(-1, -50), decimal2("-1.01"));
+                dec2_even packedEven;
+                BOOST_CHECK_EQUAL(packedEven.pack_rounded<4>(-1, -50), dec2_even("-1.00"));
+                BOOST_CHECK_EQUAL(packedEven.pack_rounded<4>(90071992547409, 9350),
+                        dec2_even("90071992547409.94"));
+
+                // rounding of extra digits read from stream
+                decimal2 d2;
+                std::istringstream in("123456789012.345678901 -0.125");
+                in >> d2;
+                BOOST_CHECK_EQUAL(d2, decimal2("123456789012.35"));
+                in >> d2;
+                BOOST_CHECK_EQUAL(d2, decimal2("-0.13"));
+
+                dec2_even d2even;
+                std::istringstream inEven("0.125 -0.135 90071992547409.995");
+                inEven >> d2even;
+                BOOST_CHECK_EQUAL(d2even, dec2_even("0.12"));
+                inEven >> d2even;
+                BOOST_CHECK_EQUAL(d2even, dec2_even("-0.14"));
+                inEven >> d2even;
+                BOOST_CHECK_EQUAL(d2even, dec2_even("90071992547410.00"));
+
+                dec0_even d0;
+                std::istringstream inZero("-2.5 3.5 2.51");
+                inZero >> d0;
+                BOOST_CHECK_EQUAL(d0, dec0_even(-2));
+                inZero >> d0;
+                BOOST_CHECK_EQUAL(d0, dec0_even(4));
+                inZero >> d0;
+                BOOST_CHECK_EQUAL(d0, dec0_even(3));
+        }
+
+BOOST_AUTO_TEST_CASE(decimalExactMult)
+        {
+                using namespace dec;
+                const decimal2 price("12.35");
+                const decimal6 rate("1.085521");
+                const decimal4 quantity("-3.1250");
+
+                const decimal<8> gross = exact_mult(price, rate);
+                BOOST_CHECK_EQUAL(gross, decimal<8>("13.40618435"));
+                const decimal<12> total = exact_mult(gross, quantity);
+                BOOST_CHECK_EQUAL(total.getUnbiased(), -41894326093750);
+                BOOST_CHECK_EQUAL(decimal_cast<2>(total), decimal2("-41.89"));
+                BOOST_CHECK_EQUAL(decimal_cast<5>(total), decimal<5>("-41.89433"));
+                BOOST_CHECK_EQUAL(exact_mult(decimal<0>(-7), decimal2("0.05")), decimal2("-0.35"));
+
+                // policies and storage of first argument
+                typedef decimal<4, half_even_round_policy, throwing_overflow_policy> dec4_throwing;
+                const decimal<6, half_even_round_policy, throwing_overflow_policy> checked =
+                        exact_mult(decimal<2, half_even_round_policy, throwing_overflow_policy>("1.5"),
+                                decimal4("2.0001"));
+                BOOST_CHECK_EQUAL(checked.getUnbiased(), 3000150);
+                BOOST_CHECK_THROW(exact_mult(dec4_throwing("1000000000"), decimal<8>("100")),
+                        std::overflow_error);
+                BOOST_CHECK(exact_mult(decimal32<2>("-12.34"), decimal32<3>("0.5"))
+                        == decimal32<5>("-6.17000"));
+
+#ifdef DEC_HAS_CONSTEXPR14
+                static_assert(exact_mult(decimal2(3), decimal4(2)).getUnbiased() == 6000000,
+                        "exact_mult");
+#endif
+#if (DEC_TYPE_LEVEL > 0) && defined(DEC_EXACT_MULT)
+                // mixed precision product is exact
+                const decimal<10> product = decimal4("0.0001") * rate;
+                BOOST_CHECK_EQUAL(product.getUnbiased(), 1085521);
+                BOOST_CHECK((std::is_same<decltype(rate * decimal4("0.0001")), const decimal<10> >::value));
+                BOOST_CHECK_EQUAL((rate * decimal4("0.0001")).getUnbiased(), 1085521);
+#elif DEC_TYPE_LEVEL > 0
+                // mixed precision product is rounded to precision of the first argument
+                BOOST_CHECK((std::is_same<decltype(rate * decimal4("0.0001")), const decimal6>::value));
+                BOOST_CHECK_EQUAL((rate * decimal4("0.0001")).getUnbiased(), 109);
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalMulDiv)
+        {
+                using namespace dec;
+                typedef decimal<2, half_even_round_policy> dec2_even;
+                typedef decimal<2, half_even_round_policy, throwing_overflow_policy> dec2_throwing;
+
+                // a * b / c rounds twice
+                BOOST_CHECK_EQUAL(dec2_even("10.05") * dec2_even("0.5") / dec2_even("3"),
+                        dec2_even("1.67"));
+                BOOST_CHECK_EQUAL(muldiv(dec2_even("10.05"), dec2_even("0.5"), dec2_even("3")),
+                        dec2_even("1.68"));
+                BOOST_CHECK_EQUAL(muldiv(decimal2("-10.05"), decimal2("0.5"), decimal2("3")),
+                        decimal2("-1.68"));
+                BOOST_CHECK_EQUAL(muldiv(decimal2("1000.00"), decimal6("1.234567"), decimal4("3.0000")),
+                        decimal2("411.52"));
+                BOOST_CHECK_EQUAL(muldiv(decimal6("1.000001"), decimal2("-0.03"), decimal<0>(7)),
+                        decimal6("-0.004286"));
+                BOOST_CHECK_EQUAL(muldiv(decimal<0>(1), decimal<0>(1), decimal<18>("0.000000000000000003")),
+                        decimal<0>(333333333333333333));
+
+                // product does not fit in 64 bits
+                const decimal2 large("50000000000000000.00");
+                BOOST_CHECK_EQUAL(muldiv(large, large, large), large);
+                BOOST_CHECK_EQUAL(muldiv(large, decimal6("3.000000"), decimal4("7.0000")),
+                        decimal2("21428571428571428.57"));
+
+                BOOST_CHECK(muldiv(decimal32<2>("12.34"), decimal6("0.5"), decimal4("2"))
+                        == decimal32<2>("3.09"));
+                BOOST_CHECK_THROW(muldiv(dec2_throwing("1000000000000000"), decimal2("10"),
+                        decimal2("0.01")), std::overflow_error);
+                BOOST_CHECK_THROW(muldiv(dec2_throwing("1"), decimal2("1"), decimal<18>("0.000000000000000001")),
+                        std::overflow_error);
+
+#ifdef DEC_HAS_INT128
+                typedef decimal<1, round_down_round_policy> dec1_down;
+                // a * b + c rounds twice, with different sign of a * b and result
+                BOOST_CHECK_EQUAL(decimal_cast<dec1_down>(decimal2("-0.25") * decimal2("0.5")) + dec1_down("1.0"),
+                        dec1_down("0.9"));
+                BOOST_CHECK_EQUAL(fma(decimal2("-0.25"), decimal2("0.5"), dec1_down("1.0")),
+                        dec1_down("0.8"));
+                BOOST_CHECK_EQUAL(fma(decimal2("10.05"), decimal2("0.5"), dec2_even("1.00")),
+                        dec2_even("6.02"));
+                BOOST_CHECK_EQUAL(fma(decimal<0>(3), decimal<1>("0.5"), decimal4("0.0001")),
+                        decimal4("1.5001"));
+                BOOST_CHECK_EQUAL(fma(decimal6("1.000001"), decimal6("-1.000001"), decimal2("1.00")),
+                        decimal2("0.00"));
+                BOOST_CHECK_EQUAL(fma(large, decimal2("0.10"), decimal2("-4000000000000000.00")),
+                        decimal2("1000000000000000.00"));
+                BOOST_CHECK_EQUAL(fma(large, decimal<0>(-1), large), decimal2(0));
+                BOOST_CHECK_THROW(fma(large, decimal2("100"), dec2_throwing(0)), std::overflow_error);
+                BOOST_CHECK_THROW(fma(large, large, dec2_throwing(0)), std::overflow_error);
+#endif
+        }
+
+#ifdef DEC_HAS_INT128
+template<class RoundPolicy>
+void test_md_tie(const std::string &name, dec::int64 expectedPos, dec::int64 expectedNeg) {
+    using namespace dec;
+    // 3 * (2^62 + 1) / 2 = 6917529027641081857.5, product does not fit in 64 bits
+    const int64 value = 4611686018427387905;
+    int64 res = dec_utils<RoundPolicy>::multDiv(value, 3, 2);
+    BOOST_CHECK_MESSAGE( res == expectedPos, "multDiv<" << name << ">(+) is " << res << ", expecting: " << expectedPos );
+    res = dec_utils<RoundPolicy>::multDiv(-value, 3, 2);
+    BOOST_CHECK_MESSAGE( res == expectedNeg, "multDiv<" << name << ">(-) is " << res << ", expecting: " << expectedNeg );
+    res = dec_utils<RoundPolicy>::multDiv(value, -3, 2);
+    BOOST_CHECK_MESSAGE( res == expectedNeg, "multDiv<" << name << ">(-) is " << res << ", expecting: " << expectedNeg );
+}
+
+BOOST_AUTO_TEST_CASE(multDivWide)
+        {
+                using namespace dec;
+                mult_div_tester tester;
+
+                // intermediate product > 2^64, exact result
+                tester.test_md(9000000000000000000, 7, 9, 7000000000000000000);
+                tester.test_md(123456789012345678, 1000000007, 1000000000, 123456789876543201);
+                tester.test_md(-123456789012345678, 1000000007, 1000000000, -123456789876543201);
+                tester.test_md(DEC_MIN_INT64, 1, 1, DEC_MIN_INT64);
+                tester.test_md(DEC_MIN_INT64, 3, -3, DEC_MIN_INT64);
+
+                test_md_tie<def_round_policy>("default", 6917529027641081858, -6917529027641081858);
+                test_md_tie<null_round_policy>("null", 6917529027641081857, -6917529027641081857);
+                test_md_tie<half_down_round_policy>("half_down", 6917529027641081857, -6917529027641081858);
+                test_md_tie<half_up_round_policy>("half_up", 6917529027641081858, -6917529027641081857);
+                test_md_tie<half_even_round_policy>("half_even", 6917529027641081858, -6917529027641081858);
+                test_md_tie<ceiling_round_policy>("ceiling", 6917529027641081858, -6917529027641081857);
+                test_md_tie<floor_round_policy>("floor", 6917529027641081857, -6917529027641081858);
+                test_md_tie<round_down_round_policy>("round_down", 6917529027641081857, -6917529027641081857);
+                test_md_tie<round_up_round_policy>("round_up", 6917529027641081858, -6917529027641081858);
+
+                // the same via decimal operators
+                decimal<6> a("2305843009213.693952");
+                decimal<6> b("2.000001");
+                BOOST_CHECK_EQUAL(a * b, decimal<6>("4611688324270.397118"));
+                BOOST_CHECK_EQUAL(decimal<6>("4611688324270.397118") / b, decimal<6>("2305843009213.693952"));
+        }
+#endif
+
 BOOST_AUTO_TEST_CASE(decimalTypeLevel)
 {
     using namespace dec;
@@ -1054,7 +1876,12 @@ BOOST_AUTO_TEST_CASE(decimalTypeLevel)
     BOOST_CHECK(d4 != decimal_cast<4>(0));
 #endif
 #if DEC_TYPE_LEVEL >= 1
+#ifdef DEC_EXACT_MULT
+    // product has precision 12
+    d8 = decimal_cast<8>(d8 * d4);
+#else
     d8 = d8 * d4;
+#endif
     BOOST_CHECK(d8 != decimal_cast<8>(0));
 #endif
 
@@ -1097,11 +1924,20 @@ BOOST_AUTO_TEST_CASE(decimalTypeLevel)
 
 BOOST_AUTO_TEST_CASE(decimalFloatConstructorHighPrec) {
     dec::decimal<2> d1(3.1549999999999998);
+#ifdef DEC_HAS_INT128
+    // shortest decimal with the same double value is 3.155
+    dec::decimal<2> d2("3.155");
+#else
     dec::decimal<2> d2("3.1549999999999998");
+#endif
     BOOST_CHECK_EQUAL(d1, d2);
 
     dec::decimal<2> d3(-3.1549999999999998);
+#ifdef DEC_HAS_INT128
+    dec::decimal<2> d4("-3.155");
+#else
     dec::decimal<2> d4("-3.1549999999999998");
+#endif
     BOOST_CHECK_EQUAL(d3, d4);
 
     dec::decimal<2> d5;
@@ -1112,3 +1948,157 @@ BOOST_AUTO_TEST_CASE(decimalFloatConstructorHighPrec) {
     d6 = 3.1549999999999998;
     BOOST_CHECK_EQUAL(d6, d2);
 }
+
+BOOST_AUTO_TEST_CASE(decimalFloatRange) {
+    typedef dec::storage_utils<dec::def_round_policy, dec::int64> utils;
+    typedef dec::decimal<0, dec::def_round_policy, dec::throwing_overflow_policy> dec0_throw;
+    typedef dec::decimal<2, dec::def_round_policy, dec::throwing_overflow_policy> dec2_throw;
+    typedef dec::decimal<4, dec::def_round_policy, dec::saturating_overflow_policy> dec4_sat;
+
+    // doubles just below and above 2^63 / factor
+    dec::int64 raw = 0;
+    BOOST_CHECK(!utils::fromFloatOverflow(922337203685477.5, 10000, raw));
+    BOOST_CHECK_EQUAL(raw, 9223372036854775000);
+    BOOST_CHECK(utils::fromFloatOverflow(922337203685477.625, 10000, raw));
+    BOOST_CHECK_EQUAL(raw, 0);
+    BOOST_CHECK(!utils::fromFloatOverflow(-922337203685477.5, 10000, raw));
+    BOOST_CHECK_EQUAL(raw, -9223372036854775000);
+    BOOST_CHECK(utils::fromFloatOverflow(-922337203685477.625, 10000, raw));
+    BOOST_CHECK(!utils::fromFloatOverflow(92233720368547744.0, 100, raw));
+    BOOST_CHECK(raw > 9223372036854774000 - 1);
+    BOOST_CHECK(utils::fromFloatOverflow(92233720368547760.0, 100, raw));
+    BOOST_CHECK(utils::fromFloatOverflow(9.3e16, 100, raw));
+    BOOST_CHECK(utils::fromFloatOverflow(1e20, 100, raw));
+    BOOST_CHECK(utils::fromFloatOverflow(std::numeric_limits<double>::quiet_NaN(), 100, raw));
+
+    // overflow policy decides the result
+    BOOST_CHECK_EQUAL(dec4_sat(922337203685477.5).getUnbiased(), 9223372036854775000);
+    BOOST_CHECK_EQUAL(dec4_sat(922337203685477.625).getUnbiased(), DEC_MAX_INT64);
+    BOOST_CHECK_EQUAL(dec4_sat(-922337203685477.625).getUnbiased(), DEC_MIN_INT64);
+    BOOST_CHECK_NO_THROW(dec2_throw(92233720368547744.0));
+    BOOST_CHECK_THROW(dec2_throw(92233720368547760.0), std::overflow_error);
+    BOOST_CHECK_THROW(dec2_throw(9.3e16), std::overflow_error);
+    BOOST_CHECK_NO_THROW(dec0_throw(-9223372036854774784.0));
+    BOOST_CHECK_THROW(dec0_throw(9223372036854775808.0), std::overflow_error);
+    BOOST_CHECK_EQUAL(dec::decimal<2>(9.3e16).getUnbiased(), 0); // unchecked
+}
+
+#ifdef DEC_HAS_INT128
+BOOST_AUTO_TEST_CASE(decimalShortestDouble) {
+    typedef dec::decimal<1, dec::half_even_round_policy> dec1_even;
+    typedef dec::decimal<2, dec::ceiling_round_policy> dec2_ceiling;
+    typedef dec::decimal<2, dec::floor_round_policy> dec2_floor;
+
+    // double -> decimal: shortest round-trip decimal, then rounding
+    BOOST_CHECK_EQUAL(dec::decimal<2>(2.675), dec::decimal<2>("2.68"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>(-2.675), dec::decimal<2>("-2.68"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>(1.005), dec::decimal<2>("1.01"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>(0.1).getUnbiased(), 10);
+    BOOST_CHECK_EQUAL(dec2_ceiling(0.1).getUnbiased(), 10);
+    BOOST_CHECK_EQUAL(dec2_ceiling(0.101).getUnbiased(), 11);
+    BOOST_CHECK_EQUAL(dec2_floor(-0.1).getUnbiased(), -10);
+    BOOST_CHECK_EQUAL(dec2_floor(-0.101).getUnbiased(), -11);
+    BOOST_CHECK_EQUAL(dec1_even(0.25).getUnbiased(), 2);
+    BOOST_CHECK_EQUAL(dec1_even(0.35).getUnbiased(), 4);
+    BOOST_CHECK_EQUAL(dec1_even(-0.45).getUnbiased(), -4);
+    BOOST_CHECK_EQUAL(dec::decimal<4>(1e-300).getUnbiased(), 0);
+    BOOST_CHECK_EQUAL(dec2_ceiling(1e-300).getUnbiased(), 1);
+    BOOST_CHECK_EQUAL(dec::decimal<2>(123456789012345.67).getUnbiased(), 12345678901234567);
+    BOOST_CHECK_EQUAL(dec::decimal<0>(9007199254740993.0).getUnbiased(), 9007199254740992);
+    BOOST_CHECK_EQUAL(dec::decimal<6>(-0.0).getUnbiased(), 0);
+
+    dec::decimal<4> d4;
+    d4.setAsDouble(1234.5678);
+    BOOST_CHECK_EQUAL(d4.getUnbiased(), 12345678);
+    BOOST_CHECK_EQUAL(d4.getAsDouble(), 1234.5678);
+
+    // decimal -> double: correctly rounded
+    BOOST_CHECK_EQUAL(dec::decimal<2>("0.07").getAsDouble(), 0.07);
+    BOOST_CHECK_EQUAL(dec::decimal<4>("123456789012345.6789").getAsDouble(), 123456789012345.6789);
+    BOOST_CHECK_EQUAL(dec::decimal<0>(9007199254740993).getAsDouble(), 9007199254740992.0);
+    BOOST_CHECK_EQUAL(dec::decimal<0>(9007199254740995).getAsDouble(), 9007199254740996.0);
+    dec::decimal<18> d18;
+    d18.setUnbiased(DEC_MAX_INT64);
+    BOOST_CHECK_EQUAL(d18.getAsDouble(), 9.223372036854775807);
+    d18.setUnbiased(-DEC_MAX_INT64);
+    BOOST_CHECK_EQUAL(d18.getAsDouble(), -9.223372036854775807);
+
+    // round trip of doubles with at most Prec decimal digits
+    const double values[] = { 0.3, 1.1, 2.675, -1234.5678, 0.0001, 98765432.1 };
+    for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        BOOST_CHECK_EQUAL(dec::decimal<4>(values[i]).getAsDouble(), values[i]);
+    }
+}
+#endif
+
+struct comma_numpunct: public std::numpunct<char> {
+protected:
+    char do_decimal_point() const {
+        return ',';
+    }
+
+    std::string do_grouping() const {
+        return "";
+    }
+};
+
+BOOST_AUTO_TEST_CASE(decimalStreamBuffer)
+        {
+                using namespace dec;
+
+                // buffered operator>> gives the same values & stream state as fromStream
+                const char *inputs[] = { "12.345 -0.005 7", "1.5,2.25;-3", " \t+.5x", "abc", "",
+                        "-", "12345678901234.56789012345 1" };
+                for (std::size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+                    std::istringstream fast(inputs[i]);
+                    std::istringstream generic(inputs[i]);
+                    for (int n = 0; n < 3; ++n) {
+                        decimal4 fastValue(1);
+                        decimal4 genericValue(1);
+                        fast >> fastValue;
+                        if (!fromStream(generic, genericValue)) {
+                            genericValue.setUnbiased(0);
+                        }
+                        BOOST_CHECK_EQUAL(fastValue, genericValue);
+                        BOOST_CHECK_EQUAL(fast.rdstate(), generic.rdstate());
+                        BOOST_CHECK_EQUAL(fast.tellg(), generic.tellg());
+                    }
+                }
+
+                // buffered operator<< gives the same text as to_chars
+                const decimal4 values[] = { decimal4(0), decimal4("-0.0005"), decimal4("123.45"),
+                        decimal4("-922337203685477.5808"), decimal4("922337203685477.5807") };
+                for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+                    std::ostringstream out;
+                    out << values[i];
+                    BOOST_CHECK_EQUAL(out.str(), toString(values[i]));
+                }
+                std::ostringstream outZero;
+                outZero << decimal<0>(-42) << ' ' << decimal<0>(7);
+                BOOST_CHECK_EQUAL(outZero.str(), "-42 7");
+
+                // field width is handled by toStream
+                std::ostringstream outWidth;
+                outWidth << std::setw(8) << decimal2("1.5");
+                std::ostringstream outWidthGeneric;
+                outWidthGeneric << std::setw(8);
+                toStream(decimal2("1.5"), outWidthGeneric);
+                BOOST_CHECK_EQUAL(outWidth.str(), outWidthGeneric.str());
+
+                // cached decimal point follows imbue()
+                std::stringstream stream;
+                stream.imbue(std::locale(std::locale::classic(), new comma_numpunct));
+                stream << decimal2("-12.5") << ' ';
+                BOOST_CHECK_EQUAL(stream.str(), "-12,50 ");
+                decimal2 parsed;
+                stream >> parsed;
+                BOOST_CHECK_EQUAL(parsed, decimal2("-12.5"));
+
+                stream.clear();
+                stream.str("");
+                stream.imbue(std::locale::classic());
+                stream << decimal2("3.25");
+                BOOST_CHECK_EQUAL(stream.str(), "3.25");
+                stream >> parsed;
+                BOOST_CHECK_EQUAL(parsed, decimal2("3.25"));
+        }
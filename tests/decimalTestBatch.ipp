@@ -0,0 +1,546 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalTestBatch.ipp
+// Purpose:     Test decimal type - batch (array) operations.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_batch.h"
+#include "decimal_column.h"
+#include "decimal_parallel.h"
+
+#include <vector>
+
+namespace {
+
+// values with mixed signs, different magnitudes and length not divisible by vector width
+template<class DecimalType>
+std::vector<DecimalType> batch_test_values(int seed) {
+    std::vector<DecimalType> result;
+    dec::int64 value = 7919 * seed;
+    for (int i = 0; i < 37; ++i) {
+        value = (value * 48271 + 11) % 2147483647;
+        DecimalType item;
+        item.setUnbiased(((i % 3 == 0) ? -value : value) * ((i % 5 == 0) ? 100000 : 1));
+        result.push_back(item);
+    }
+    return result;
+}
+
+template<class DecimalType>
+DecimalType batch_unbiased(dec::int64 value) {
+    DecimalType result;
+    result.setUnbiased(value);
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalBatchArithmetic)
+        {
+                using namespace dec;
+                const std::vector<decimal4> a = batch_test_values<decimal4>(1);
+                const std::vector<decimal4> b = batch_test_values<decimal4>(2);
+                std::vector<decimal4> out(a.size());
+                std::vector<int> outInt(a.size());
+
+                batch::add<decimal4>(a, b, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], a[i] + b[i]);
+
+                batch::sub<decimal4>(a, b, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], a[i] - b[i]);
+
+                batch::mul<decimal4>(a, -12345, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], a[i] * static_cast<int64>(-12345));
+
+                batch::neg<decimal4>(a, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], -a[i]);
+
+                batch::abs<decimal4>(a, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], a[i].abs());
+
+                batch::min<decimal4>(a, b, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], (a[i] < b[i]) ? a[i] : b[i]);
+
+                batch::max<decimal4>(a, b, out);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(out[i], (a[i] > b[i]) ? a[i] : b[i]);
+
+                batch::sign<decimal4>(a, outInt);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(outInt[i], a[i].sign());
+
+                batch::compare<decimal4>(a, a, outInt);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(outInt[i], 0);
+
+                batch::compare<decimal4>(a, b, outInt);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(outInt[i], (a[i] - b[i]).sign());
+
+                // in-place operation on part of array
+                std::vector<decimal4> inPlace(a);
+                batch::span<decimal4> head(&inPlace[0], 10);
+                batch::add<decimal4>(head, head, head);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(inPlace[i], (i < 10) ? a[i] + a[i] : a[i]);
+
+                // other storage types are rejected at compile time
+                BOOST_CHECK(batch::details::int64_storage<decimal4>::value);
+                BOOST_CHECK(!batch::details::int64_storage<decimal32<2> >::value);
+#ifdef DEC_HAS_INT128
+                BOOST_CHECK(!batch::details::int64_storage<decimal128<2> >::value);
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalBatchRescale)
+        {
+                using namespace dec;
+                typedef decimal<2, half_even_round_policy> decimal2_even;
+                std::vector<decimal6> a = batch_test_values<decimal6>(3);
+                // extreme values and ties
+                const int64 extremes[] = { DEC_MAX_INT64, DEC_MIN_INT64 + 1, DEC_MIN_INT64,
+                        DEC_MAX_INT64 - 5000, 25000, -25000, 35000, -35000, 5000, -5000 };
+                for (size_t i = 0; i < sizeof(extremes) / sizeof(extremes[0]); ++i)
+                    a.push_back(batch_unbiased<decimal6>(extremes[i]));
+                std::vector<decimal2_even> down(a.size());
+                std::vector<decimal6> up(a.size());
+
+                batch::rescale<decimal2_even, decimal6>(a, down);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(down[i], decimal_cast<decimal2_even>(a[i]));
+                BOOST_CHECK_EQUAL(down[37].getUnbiased(), 922337203685478);
+                BOOST_CHECK_EQUAL(down[38].getUnbiased(), -922337203685478);
+                BOOST_CHECK_EQUAL(down[41].getUnbiased(), 2);
+                BOOST_CHECK_EQUAL(down[42].getUnbiased(), -2);
+                BOOST_CHECK_EQUAL(down[43].getUnbiased(), 4);
+
+                const decimal4 wide[] = { batch_unbiased<decimal4>(DEC_MAX_INT64),
+                        batch_unbiased<decimal4>(DEC_MIN_INT64 + 1) };
+                decimal2 narrow[2];
+                batch::rescale<decimal2, decimal4>(wide, narrow);
+                BOOST_CHECK_EQUAL(narrow[0].getUnbiased(), 92233720368547758);
+                BOOST_CHECK_EQUAL(narrow[1].getUnbiased(), -92233720368547758);
+
+                // extreme values wrap around
+                batch::rescale<decimal6, decimal2_even>(down, up);
+                for (size_t i = 0; i < a.size(); ++i)
+                    BOOST_CHECK_EQUAL(up[i].getUnbiased(), static_cast<int64>(
+                            static_cast<uint64>(down[i].getUnbiased()) * 10000));
+        }
+
+namespace {
+
+template<class RoundPolicy>
+void test_batch_mul_div(const std::string &name) {
+    using namespace dec;
+    typedef decimal<2, RoundPolicy> dec_type;
+    std::vector<dec_type> a = batch_test_values<dec_type>(4);
+    std::vector<dec_type> b = batch_test_values<dec_type>(5);
+    // small values give many ties (x.5) after multiplication & division
+    for (int i = -30; i <= 30; ++i) {
+        a.push_back(dec_type().pack(0, i * 5));
+        b.push_back(dec_type().pack(i % 7, (i % 7) * 50));
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        if (b[i].getUnbiased() == 0)
+            b[i].setUnbiased(3);
+    }
+    const dec_type scalar = dec_type().pack(-3, -25);
+    std::vector<dec_type> out(a.size());
+
+    batch::mul<dec_type>(a, b, out);
+    for (size_t i = 0; i < a.size(); ++i)
+        BOOST_CHECK_MESSAGE(out[i] == a[i] * b[i], "batch mul<" << name << ">(" << a[i] << ", " << b[i] << ") is " << out[i]);
+
+    batch::mul<dec_type>(a, scalar, out);
+    for (size_t i = 0; i < a.size(); ++i)
+        BOOST_CHECK_MESSAGE(out[i] == a[i] * scalar, "batch mul<" << name << ">(" << a[i] << ", " << scalar << ") is " << out[i]);
+
+    batch::div<dec_type>(a, b, out);
+    for (size_t i = 0; i < a.size(); ++i)
+        BOOST_CHECK_MESSAGE(out[i] == a[i] / b[i], "batch div<" << name << ">(" << a[i] << ", " << b[i] << ") is " << out[i]);
+
+    batch::div<dec_type>(a, scalar, out);
+    for (size_t i = 0; i < a.size(); ++i)
+        BOOST_CHECK_MESSAGE(out[i] == a[i] / scalar, "batch div<" << name << ">(" << a[i] << ", " << scalar << ") is " << out[i]);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalBatchMulDiv)
+        {
+                using namespace dec;
+                test_batch_mul_div<def_round_policy>("default");
+                test_batch_mul_div<null_round_policy>("null");
+                test_batch_mul_div<half_down_round_policy>("half_down");
+                test_batch_mul_div<half_up_round_policy>("half_up");
+                test_batch_mul_div<half_even_round_policy>("half_even");
+                test_batch_mul_div<ceiling_round_policy>("ceiling");
+                test_batch_mul_div<floor_round_policy>("floor");
+                test_batch_mul_div<round_down_round_policy>("round_down");
+                test_batch_mul_div<round_up_round_policy>("round_up");
+        }
+
+BOOST_AUTO_TEST_CASE(invariantDivider)
+        {
+#ifdef DEC_HAS_INT128
+                using namespace dec;
+                const uint64 divisors[] = { 1, 3, 10, 100000000, 999999999999999989ULL,
+                        (static_cast<uint64>(1) << 63) + 12345, ~static_cast<uint64>(0) };
+                for (size_t i = 0; i < sizeof(divisors) / sizeof(divisors[0]); ++i) {
+                    const invariant_divider divider(divisors[i]);
+                    uint64 hi = divisors[i] / 3;
+                    uint64 lo = 0x123456789ABCDEFULL * (i + 1);
+                    for (int j = 0; j < 4; ++j, hi = (hi / 2 + j) % divisors[i], lo = ~lo) {
+                        const uint128 dividend = (static_cast<uint128>(hi) << 64) | lo;
+                        uint64 remainder = 0;
+                        const uint64 quotient = divider.divide(hi, lo, remainder);
+                        BOOST_CHECK(quotient == static_cast<uint64>(dividend / divisors[i]));
+                        BOOST_CHECK(remainder == static_cast<uint64>(dividend % divisors[i]));
+                    }
+                }
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalBatchReduce)
+        {
+                using namespace dec;
+                std::vector<decimal4> a = batch_test_values<decimal4>(6);
+                a[17] = a[3] = batch_unbiased<decimal4>(-(DEC_MAX_INT64 / 4));
+                a[30] = a[21] = batch_unbiased<decimal4>(DEC_MAX_INT64 / 4);
+                a[5] = a[8] = a[36] = decimal4(0);
+
+                decimal4 expectedSum;
+                decimal4 expectedMin = a[0];
+                decimal4 expectedMax = a[0];
+                size_t expectedNonZero = 0;
+                for (size_t i = 0; i < a.size(); ++i) {
+                    expectedSum += a[i];
+                    expectedMin = (a[i] < expectedMin) ? a[i] : expectedMin;
+                    expectedMax = (a[i] > expectedMax) ? a[i] : expectedMax;
+                    expectedNonZero += (a[i].getUnbiased() == 0) ? 0 : 1;
+                }
+
+                decimal4 total;
+                BOOST_CHECK(batch::sum<decimal4>(a, total));
+                BOOST_CHECK_EQUAL(total, expectedSum);
+                BOOST_CHECK_EQUAL(batch::min<decimal4>(a), expectedMin);
+                BOOST_CHECK_EQUAL(batch::max<decimal4>(a), expectedMax);
+                BOOST_CHECK_EQUAL(batch::argmin<decimal4>(a), 3u);
+                BOOST_CHECK_EQUAL(batch::argmax<decimal4>(a), 21u);
+                BOOST_CHECK_EQUAL(batch::count_nonzero<decimal4>(a), expectedNonZero);
+                BOOST_CHECK_EQUAL(batch::mean<decimal4>(a), expectedSum / decimal4(static_cast<int>(a.size())));
+
+                // sum overflows, but mean does not
+                std::vector<decimal4> big(9, batch_unbiased<decimal4>(DEC_MAX_INT64 - 5));
+                BOOST_CHECK(!batch::sum<decimal4>(big, total));
+                BOOST_CHECK_EQUAL(batch::mean<decimal4>(big).getUnbiased(), DEC_MAX_INT64 - 5);
+                big.assign(13, batch_unbiased<decimal4>(DEC_MIN_INT64));
+                BOOST_CHECK(!batch::sum<decimal4>(big, total));
+                BOOST_CHECK_EQUAL(batch::mean<decimal4>(big).getUnbiased(), DEC_MIN_INT64);
+                big.push_back(batch_unbiased<decimal4>(DEC_MAX_INT64));
+                big.push_back(batch_unbiased<decimal4>(DEC_MAX_INT64));
+                BOOST_CHECK_EQUAL(batch::argmax<decimal4>(big), 13u);
+
+                // mean rounding: -0.0005 / 2 and 0.0005 / 2
+                typedef decimal<3, half_even_round_policy> decimal3_even;
+                std::vector<decimal3_even> ties;
+                ties.push_back(batch_unbiased<decimal3_even>(0));
+                ties.push_back(batch_unbiased<decimal3_even>(-5));
+                BOOST_CHECK_EQUAL(batch::mean<decimal3_even>(ties).getUnbiased(), -2);
+                ties[1].setUnbiased(7);
+                BOOST_CHECK_EQUAL(batch::mean<decimal3_even>(ties).getUnbiased(), 4);
+
+                std::vector<decimal4> empty;
+                BOOST_CHECK(batch::sum<decimal4>(empty, total));
+                BOOST_CHECK_EQUAL(total, decimal4(0));
+                BOOST_CHECK_EQUAL(batch::mean<decimal4>(empty), decimal4(0));
+                BOOST_CHECK_EQUAL(batch::argmin<decimal4>(empty), 0u);
+                BOOST_CHECK_EQUAL(batch::count_nonzero<decimal4>(empty), 0u);
+        }
+
+#ifdef DEC_HAS_INT128
+BOOST_AUTO_TEST_CASE(decimalBatchDot)
+        {
+                using namespace dec;
+                typedef decimal<6, half_even_round_policy> decimal6_even;
+                // results fit in 64 bits with precision 6
+                std::vector<decimal4> prices = batch_test_values<decimal4>(8);
+                std::vector<decimal2> quantities = batch_test_values<decimal2>(9);
+                std::vector<int64> counts;
+                int128 exact = 0;
+                int128 exactWeighted = 0;
+                for (size_t i = 0; i < prices.size(); ++i) {
+                    prices[i].setUnbiased(prices[i].getUnbiased() / 1000000);
+                    quantities[i].setUnbiased(quantities[i].getUnbiased() / 1000000);
+                    counts.push_back(quantities[i].getUnbiased() / 10);
+                    exact += static_cast<int128>(prices[i].getUnbiased()) * quantities[i].getUnbiased();
+                    exactWeighted += static_cast<int128>(prices[i].getUnbiased()) * counts[i];
+                }
+
+                // precision 6 of products is kept, then rounded to 4 and 2 digits
+                decimal6_even dot6;
+                BOOST_CHECK((batch::dot<decimal6_even, decimal4, decimal2>(prices, quantities, dot6)));
+                BOOST_CHECK(static_cast<int128>(dot6.getUnbiased()) == exact);
+                decimal4 dot4;
+                BOOST_CHECK((batch::dot<decimal4, decimal4, decimal2>(prices, quantities, dot4)));
+                BOOST_CHECK_EQUAL(dot4, decimal_cast<decimal4>(dot6));
+
+                decimal2 weighted;
+                BOOST_CHECK((batch::weighted_sum<decimal2, decimal4>(prices, counts, weighted)));
+                const decimal<4, def_round_policy> weighted4 = batch_unbiased<decimal4>(
+                        static_cast<int64>(exactWeighted));
+                BOOST_CHECK_EQUAL(weighted, decimal_cast<decimal2>(weighted4));
+                decimal<6> weighted6;
+                BOOST_CHECK((batch::weighted_sum<decimal<6>, decimal4>(prices, counts, weighted6)));
+                BOOST_CHECK_EQUAL(weighted6, decimal_cast<6>(weighted4));
+
+                // rounding once: 0.005 + 0.005 + 0.005 would give 0.03 when rounded per row
+                const std::vector<decimal4> halfCents(3, decimal4("0.0050"));
+                const std::vector<decimal2> ones(3, decimal2("1.00"));
+                decimal2 cents;
+                BOOST_CHECK((batch::dot<decimal2, decimal4, decimal2>(halfCents, ones, cents)));
+                BOOST_CHECK_EQUAL(cents, decimal2("0.02"));
+                const int64 unit[] = { 1, 1, 1 };
+                BOOST_CHECK((batch::weighted_sum<decimal2, decimal4>(halfCents, unit, cents)));
+                BOOST_CHECK_EQUAL(cents, decimal2("0.02"));
+
+                // overflow and shorter second span
+                const std::vector<decimal4> big(2, batch_unbiased<decimal4>(DEC_MAX_INT64));
+                decimal4 result("1");
+                BOOST_CHECK(!(batch::dot<decimal4, decimal4, decimal2>(big, ones, result)));
+                BOOST_CHECK_EQUAL(result, decimal4("1"));
+                BOOST_CHECK((batch::dot<decimal4, decimal4, decimal2>(big,
+                        batch::span<const decimal2>(&ones[0], 1), result)));
+                BOOST_CHECK_EQUAL(result, big[0]);
+
+                std::vector<decimal4> empty;
+                BOOST_CHECK((batch::dot<decimal4, decimal4, decimal2>(empty, ones, result)));
+                BOOST_CHECK_EQUAL(result, decimal4(0));
+        }
+#endif
+
+BOOST_AUTO_TEST_CASE(decimalColumn)
+        {
+                using namespace dec;
+                const std::vector<decimal2> source = batch_test_values<decimal2>(7);
+                decimal_column<2> column(source);
+                BOOST_CHECK_EQUAL(column.size(), source.size());
+                BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(column.data()) % decimal_column<2>::alignment, 0u);
+
+                // views share memory with column
+                BOOST_CHECK(static_cast<const void *>(column.unbiased().data()) == column.data());
+                column.unbiased()[2] = 1234;
+                BOOST_CHECK_EQUAL(column[2], decimal2("12.34"));
+                column[2] = source[2];
+
+                decimal2 total;
+                BOOST_CHECK(column.sum(total));
+                decimal2 expected;
+                BOOST_CHECK(batch::sum<decimal2>(source, expected));
+                BOOST_CHECK_EQUAL(total, expected);
+                BOOST_CHECK_EQUAL(column.mean(), batch::mean<decimal2>(source));
+                BOOST_CHECK_EQUAL(column.min(), batch::min<decimal2>(source));
+                BOOST_CHECK_EQUAL(column.max(), batch::max<decimal2>(source));
+                BOOST_CHECK_EQUAL(column.argmin(), batch::argmin<decimal2>(source));
+                BOOST_CHECK_EQUAL(column.argmax(), batch::argmax<decimal2>(source));
+                BOOST_CHECK_EQUAL(column.count_nonzero(), source.size());
+
+                // column works directly with batch functions
+                batch::neg<decimal2>(column, column);
+                BOOST_CHECK_EQUAL(column.max(), -batch::min<decimal2>(source));
+
+                column.push_back(decimal2(0));
+                column.resize(100);
+                BOOST_CHECK_EQUAL(column.count_nonzero(), source.size());
+                BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(column.data()) % decimal_column<2>::alignment, 0u);
+        }
+
+BOOST_AUTO_TEST_CASE(decimalBatchFormat)
+        {
+                using namespace dec;
+                std::vector<decimal4> values = batch_test_values<decimal4>(11);
+                values.push_back(decimal4(0));
+                values.push_back(decimal4("-0.0001"));
+                values.push_back(decimal4("0.05"));
+                values.push_back(batch_unbiased<decimal4>(DEC_MAX_INT64));
+                values.push_back(batch_unbiased<decimal4>(DEC_MIN_INT64));
+                std::string expected;
+                for (size_t i = 0; i < values.size(); ++i) {
+                    expected += toString(values[i]) + ";";
+                }
+
+                std::vector<char> buffer(batch::format_capacity<decimal4>(values.size()));
+                std::vector<size_t> offsets(values.size() + 1);
+                to_chars_result res = batch::format<decimal4>(values, buffer.data(),
+                        buffer.data() + buffer.size(), ';', offsets);
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK_EQUAL(std::string(buffer.data(), res.ptr), expected);
+                BOOST_CHECK_EQUAL(offsets[0], 0u);
+                BOOST_CHECK_EQUAL(offsets[values.size()], expected.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    BOOST_CHECK_EQUAL(std::string(buffer.data() + offsets[i], buffer.data() + offsets[i + 1] - 1),
+                            toString(values[i]));
+                }
+
+                // exact size is enough, smaller buffer is not changed
+                res = batch::format<decimal4>(values, buffer.data(), buffer.data() + expected.size(), ';');
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK(res.ptr == buffer.data() + expected.size());
+                buffer.assign(buffer.size(), '*');
+                res = batch::format<decimal4>(values, buffer.data(), buffer.data() + expected.size() - 1);
+                BOOST_CHECK(res.ec == std::errc::value_too_large);
+                BOOST_CHECK(res.ptr == buffer.data() + expected.size() - 1);
+                BOOST_CHECK_EQUAL(buffer[0], '*');
+
+                // offsets without place for total length
+                buffer.assign(buffer.size(), '*');
+                res = batch::format<decimal4>(values, buffer.data(), buffer.data() + buffer.size(), ';',
+                        batch::span<size_t>(offsets.data(), values.size()));
+                BOOST_CHECK(res.ec == std::errc::invalid_argument);
+                BOOST_CHECK(res.ptr == buffer.data());
+                BOOST_CHECK_EQUAL(buffer[0], '*');
+
+                BOOST_CHECK_EQUAL(batch::format_capacity<decimal4>(2), 2 * (storage_traits<int64>::max_chars + 1u));
+                BOOST_CHECK_EQUAL(batch::format_capacity<decimal4>((std::numeric_limits<size_t>::max)() / 8),
+                        (std::numeric_limits<size_t>::max)());
+
+                const decimal<0> integers[] = { decimal<0>(-12), decimal<0>(0), decimal<0>(1000) };
+                char text[16];
+                res = batch::format<decimal<0> >(integers, text, text + sizeof(text));
+                BOOST_CHECK_EQUAL(std::string(text, res.ptr), "-12\n0\n1000\n");
+        }
+
+BOOST_AUTO_TEST_CASE(decimalParallelReduce)
+        {
+                using namespace dec;
+                // several chunks with last one incomplete
+                std::vector<decimal4> a(3 * details::parallel_chunk_size + 1234);
+                std::vector<decimal2> b(a.size());
+                dec::int64 value = 17;
+                for (size_t i = 0; i < a.size(); ++i) {
+                    value = (value * 48271 + 11) % 2147483647;
+                    a[i].setUnbiased((i % 3 == 0) ? -value * 1000 : value * 1000);
+                    b[i].setUnbiased(value % 100000 - 50000);
+                }
+                a[100000] = batch_unbiased<decimal4>(DEC_MAX_INT64 / 2);
+                a[150000] = batch_unbiased<decimal4>(DEC_MIN_INT64 / 2);
+
+                decimal4 expected;
+                BOOST_CHECK(batch::sum<decimal4>(a, expected));
+                const unsigned threads[] = { 1, 2, 3, 8, 0 };
+                for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+                    decimal4 total;
+                    BOOST_CHECK(parallel_sum<decimal4>(a, total, threads[i]));
+                    BOOST_CHECK_EQUAL(total, expected);
+
+                    decimal4 minValue, maxValue;
+                    BOOST_CHECK(parallel_minmax<decimal4>(a, minValue, maxValue, threads[i]));
+                    BOOST_CHECK_EQUAL(minValue, a[150000]);
+                    BOOST_CHECK_EQUAL(maxValue, a[100000]);
+                }
+
+                // partial sums overflow, but total does not
+                std::vector<decimal4> big(a.size(), batch_unbiased<decimal4>(DEC_MAX_INT64 / 2));
+                for (size_t i = big.size() / 2; i < big.size(); ++i)
+                    big[i] = -big[i];
+                decimal4 total("1");
+                BOOST_CHECK(parallel_sum<decimal4>(big, total, 4));
+                BOOST_CHECK_EQUAL(total, decimal4(0));
+                big.back() = big.front();
+                big[big.size() - 2] = big.front();
+                BOOST_CHECK(!parallel_sum<decimal4>(big, total, 4));
+                BOOST_CHECK_EQUAL(total, decimal4(0));
+
+                std::vector<decimal4> empty;
+                decimal4 minValue, maxValue;
+                BOOST_CHECK(parallel_sum<decimal4>(empty, total));
+                BOOST_CHECK_EQUAL(total, decimal4(0));
+                BOOST_CHECK(!parallel_minmax<decimal4>(empty, minValue, maxValue));
+
+#ifdef DEC_HAS_INT128
+                // exact dot product rounded once
+                a[100000] = a[99999];
+                a[150000] = a[149999];
+                int128 exact = 0;
+                for (size_t i = 0; i < a.size(); ++i)
+                    exact += static_cast<int128>(a[i].getUnbiased()) * b[i].getUnbiased();
+                const uint128 magnitude = (exact < 0) ? 0 - static_cast<uint128>(exact) : static_cast<uint128>(exact);
+                uint128 rounded = magnitude / 10000 + ((magnitude % 10000 >= 5000) ? 1 : 0);
+                const int64 expectedDot = static_cast<int64>((exact < 0) ? 0 - rounded : rounded);
+                for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+                    decimal2 dot;
+                    BOOST_CHECK((parallel_dot<decimal2, decimal4, decimal2>(a, b, dot, threads[i])));
+                    BOOST_CHECK_EQUAL(dot.getUnbiased(), expectedDot);
+                }
+                const decimal4 bigPrice[] = { batch_unbiased<decimal4>(DEC_MAX_INT64 / 2) };
+                const decimal2 bigQuantity[] = { decimal2(3) };
+                decimal4 dot4("1");
+                BOOST_CHECK(!(parallel_dot<decimal4, decimal4, decimal2>(bigPrice, bigQuantity, dot4)));
+                BOOST_CHECK_EQUAL(dot4, decimal4("1"));
+
+                typedef decimal<12> decimal12;
+                std::vector<decimal12> prices(3, decimal12("1.5"));
+                std::vector<decimal12> quantities(3, decimal12("-0.75"));
+                quantities[2] = decimal12("2.25");
+                decimal2 dot;
+                BOOST_CHECK((parallel_dot<decimal2, decimal12, decimal12>(prices, quantities, dot)));
+                BOOST_CHECK_EQUAL(dot, decimal2("1.13"));
+                decimal<10, floor_round_policy> dot10;
+                const batch::span<const decimal2> head(&b[0], 10);
+                BOOST_CHECK((parallel_dot<decimal<10, floor_round_policy>, decimal2, decimal2>(
+                        head, head, dot10)));
+                BOOST_CHECK(dot10.getUnbiased() > 0);
+                BOOST_CHECK_EQUAL(dot10.getUnbiased() % 1000000, 0);
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalParallelFormat)
+        {
+                using namespace dec;
+                std::vector<decimal2> values(3 * details::parallel_chunk_size + 1234);
+                int64 value = 17;
+                for (size_t i = 0; i < values.size(); ++i) {
+                    value = (value * 48271 + 11) % 2147483647;
+                    values[i].setUnbiased((i % 3 == 0) ? -value / static_cast<int64>(i % 1000 + 1) : value);
+                }
+
+                std::vector<char> expected(batch::format_capacity<decimal2>(values.size()));
+                std::vector<size_t> expectedOffsets(values.size() + 1);
+                const to_chars_result expectedRes = batch::format<decimal2>(values, expected.data(),
+                        expected.data() + expected.size(), ',', expectedOffsets);
+                const size_t length = static_cast<size_t>(expectedRes.ptr - expected.data());
+
+                const unsigned threads[] = { 1, 4 };
+                for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+                    // exact size of output is enough
+                    std::vector<char> buffer(length);
+                    std::vector<size_t> offsets(values.size() + 1);
+                    const to_chars_result res = parallel_format<decimal2>(values, buffer.data(),
+                            buffer.data() + buffer.size(), ',', offsets, threads[i]);
+                    BOOST_CHECK(res.ec == std::errc());
+                    BOOST_CHECK(res.ptr == buffer.data() + length);
+                    BOOST_CHECK(std::equal(buffer.begin(), buffer.end(), expected.begin()));
+                    BOOST_CHECK(offsets == expectedOffsets);
+                }
+
+                std::vector<char> buffer(length);
+                std::vector<size_t> shortOffsets(values.size());
+                const to_chars_result invalid = parallel_format<decimal2>(values, buffer.data(),
+                        buffer.data() + buffer.size(), ',', shortOffsets, 4);
+                BOOST_CHECK(invalid.ec == std::errc::invalid_argument);
+                BOOST_CHECK(invalid.ptr == buffer.data());
+
+                std::vector<char> small(length - 1);
+                const to_chars_result res = parallel_format<decimal2>(values, small.data(),
+                        small.data() + small.size(), ',');
+                BOOST_CHECK(res.ec == std::errc::value_too_large);
+                BOOST_CHECK(res.ptr == small.data() + small.size());
+        }
@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalTestCodec.ipp
+// Purpose:     Test decimal type - binary encoding of decimal arrays.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_codec.h"
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(decimalCodecRoundTrip)
+        {
+                using namespace dec;
+
+                // time series with small steps, extreme values and wrapping deltas
+                std::vector<decimal4> values;
+                int64 price = 1234567;
+                for (int i = 0; i < 1001; ++i) {
+                    price += (i * 7919) % 23 - 11;
+                    decimal4 item;
+                    item.setUnbiased(price);
+                    values.push_back(item);
+                }
+                values[10].setUnbiased(0);
+                values[11].setUnbiased(DEC_MIN_INT64);
+                values[12].setUnbiased(DEC_MAX_INT64);
+                values[13].setUnbiased(-1);
+
+                const codec::encoding methods[] = { codec::varint, codec::delta_varint,
+                        codec::group_varint, codec::delta_group_varint };
+                std::vector<std::size_t> sizes;
+                for (std::size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); ++m) {
+                    // all value counts of the last group
+                    for (std::size_t count = values.size() - 4; count <= values.size(); ++count) {
+                        const batch::span<const decimal4> input(values.data(), count);
+                        std::vector<char> buffer(codec::capacity(count));
+                        const to_chars_result res = codec::encode<decimal4>(input, buffer.data(),
+                                buffer.data() + buffer.size(), methods[m]);
+                        BOOST_REQUIRE(res.ec == std::errc());
+
+                        codec::header info;
+                        BOOST_CHECK(codec::read_header(buffer.data(), res.ptr, info).ec == std::errc());
+                        BOOST_CHECK_EQUAL(info.method, methods[m]);
+                        BOOST_CHECK_EQUAL(info.precision, 4);
+                        BOOST_CHECK_EQUAL(info.count, count);
+
+                        decimal_column<4> output;
+                        const from_chars_result in = codec::decode(buffer.data(), res.ptr, output);
+                        BOOST_CHECK(in.ec == std::errc());
+                        BOOST_CHECK(in.ptr == res.ptr);
+                        BOOST_REQUIRE_EQUAL(output.size(), count);
+                        BOOST_CHECK(std::equal(input.begin(), input.end(), output.data()));
+                        if (count == values.size()) {
+                            sizes.push_back(static_cast<std::size_t>(res.ptr - buffer.data()));
+                        }
+                    }
+                }
+                // deltas are shorter, everything is shorter than raw values
+                BOOST_CHECK(sizes[1] < sizes[0]);
+                BOOST_CHECK(sizes[3] < sizes[2]);
+                BOOST_CHECK(sizes[1] < values.size() * 3);
+                BOOST_CHECK(sizes[0] < values.size() * sizeof(int64));
+
+                // exact size of output is enough, smaller one is reported
+                const batch::span<const decimal4> input(values);
+                std::vector<char> buffer(sizes[1]);
+                BOOST_CHECK(codec::encode<decimal4>(input, buffer.data(), buffer.data() + buffer.size()).ec
+                        == std::errc());
+                const to_chars_result res = codec::encode<decimal4>(input, buffer.data(),
+                        buffer.data() + buffer.size() - 1);
+                BOOST_CHECK(res.ec == std::errc::value_too_large);
+                BOOST_CHECK(res.ptr == buffer.data() + buffer.size() - 1);
+
+                BOOST_CHECK_EQUAL(codec::capacity((std::numeric_limits<std::size_t>::max)() / 4),
+                        (std::numeric_limits<std::size_t>::max)());
+
+                // empty block
+                char empty[codec::max_header_size];
+                const to_chars_result emptyRes = codec::encode<decimal4>(batch::span<const decimal4>(),
+                        empty, empty + sizeof(empty));
+                std::vector<decimal4> output(3);
+                BOOST_CHECK(codec::decode(empty, emptyRes.ptr, output).ec == std::errc());
+                BOOST_CHECK(output.empty());
+        }
+
+BOOST_AUTO_TEST_CASE(decimalCodecValidation)
+        {
+                using namespace dec;
+
+                const decimal2 values[] = { decimal2("1.5"), decimal2("-2.25"), decimal2("1000"),
+                        decimal2("0.01"), decimal2("-7") };
+                char buffer[64];
+                const char *end = codec::encode<decimal2>(values, buffer, buffer + sizeof(buffer),
+                        codec::delta_group_varint).ptr;
+
+                // blocks can be concatenated
+                const char *second = codec::encode<decimal2>(values, const_cast<char *>(end),
+                        buffer + sizeof(buffer), codec::varint).ptr;
+                std::vector<decimal2> output;
+                from_chars_result res = codec::decode(buffer, second, output);
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK(res.ptr == end);
+                res = codec::decode(res.ptr, second, output);
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK(res.ptr == second);
+                BOOST_REQUIRE_EQUAL(output.size(), 5u);
+                BOOST_CHECK_EQUAL(output[2], decimal2("1000"));
+
+                // higher output precision is exact, lower is not allowed
+                std::vector<decimal6> wide;
+                BOOST_CHECK(codec::decode(buffer, end, wide).ec == std::errc());
+                BOOST_REQUIRE_EQUAL(wide.size(), 5u);
+                BOOST_CHECK_EQUAL(wide[1], decimal6("-2.25"));
+                std::vector<decimal<1> > narrow(2);
+                res = codec::decode(buffer, end, narrow);
+                BOOST_CHECK(res.ec == std::errc::result_out_of_range);
+                BOOST_CHECK(narrow.empty());
+                decimal2 big[1];
+                big[0].setUnbiased(DEC_MAX_INT64 / 1000);
+                char bigBuffer[32];
+                const char *bigEnd = codec::encode<decimal2>(batch::span<const decimal2>(big, 1), bigBuffer,
+                        bigBuffer + sizeof(bigBuffer)).ptr;
+                BOOST_CHECK(codec::decode(bigBuffer, bigEnd, wide).ec == std::errc::result_out_of_range);
+
+                // every truncated block is invalid
+                for (const char *last = buffer; last < end; ++last) {
+                    BOOST_CHECK(codec::decode(buffer, last, output).ec == std::errc::invalid_argument);
+                    BOOST_CHECK(output.empty());
+                }
+
+                // corrupted header and data
+                std::vector<char> corrupted(static_cast<const char *>(buffer), end);
+                corrupted[0] = 'X';
+                BOOST_CHECK(codec::decode(corrupted.data(), corrupted.data() + corrupted.size(), output).ec
+                        == std::errc::invalid_argument);
+                corrupted[0] = 'D';
+                corrupted[2] = static_cast<char>((codec::format_version << 4) | 9);
+                BOOST_CHECK(codec::decode(corrupted.data(), corrupted.data() + corrupted.size(), output).ec
+                        == std::errc::invalid_argument);
+                corrupted[2] = buffer[2];
+                corrupted[3] = 19;
+                BOOST_CHECK(codec::decode(corrupted.data(), corrupted.data() + corrupted.size(), output).ec
+                        == std::errc::invalid_argument);
+                corrupted[3] = buffer[3];
+                // huge count is detected before allocation
+                corrupted[4] = static_cast<char>(0xff);
+                BOOST_CHECK(codec::decode(corrupted.data(), corrupted.data() + corrupted.size(), output).ec
+                        == std::errc::invalid_argument);
+                corrupted[4] = buffer[4];
+                // length of unused value in the last group
+                corrupted[5 + 2 + 10] |= 0x70;
+                BOOST_CHECK(codec::decode(corrupted.data(), corrupted.data() + corrupted.size(), output).ec
+                        == std::errc::invalid_argument);
+
+                // varint longer than 64 bits
+                const unsigned char overlong[] = { 'D', 'C', (codec::format_version << 4) | codec::varint, 2, 1,
+                        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02 };
+                const char *text = reinterpret_cast<const char *>(overlong);
+                BOOST_CHECK(codec::decode(text, text + sizeof(overlong), output).ec == std::errc::invalid_argument);
+        }
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalTestCsv.ipp
+// Purpose:     Test decimal type - bulk CSV parsing.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_csv.h"
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(decimalCsvReader)
+        {
+                using namespace dec;
+
+                const std::string text =
+                        "symbol;price;quantity;note\r\n"
+                        "ABC;12.5;100;first\r\n"
+                        "DEF;-0.00005;2.345;rounded\r\n"
+                        "GHI;x1;3\r\n"
+                        "JKL;99999999999999999999;4;too large\r\n"
+                        "MNO;7.25\r\n"
+                        "PQR;1;;empty quantity\n"
+                        "STU;0.0001;1.005";
+                decimal_column<4> prices;
+                std::vector<decimal2> quantities;
+                csv_reader reader(';', true);
+                reader.column(2, quantities).column(1, prices);
+                std::vector<csv_error> errors;
+                const std::size_t rows = reader.parse(text.data(), text.data() + text.size(), errors);
+
+                BOOST_CHECK_EQUAL(rows, 7u);
+                BOOST_CHECK_EQUAL(prices.size(), 7u);
+                BOOST_CHECK_EQUAL(quantities.size(), 7u);
+                BOOST_CHECK_EQUAL(prices[0], decimal4("12.5"));
+                BOOST_CHECK_EQUAL(quantities[0], decimal2(100));
+                BOOST_CHECK_EQUAL(prices[1], decimal4("-0.0001"));
+                BOOST_CHECK_EQUAL(quantities[1], decimal2("2.35"));
+                BOOST_CHECK_EQUAL(prices[2], decimal4(0));
+                BOOST_CHECK_EQUAL(quantities[2], decimal2(3));
+                BOOST_CHECK_EQUAL(prices[3], decimal4(0));
+                BOOST_CHECK_EQUAL(prices[4], decimal4("7.25"));
+                BOOST_CHECK_EQUAL(quantities[4], decimal2(0));
+                BOOST_CHECK_EQUAL(quantities[5], decimal2(0));
+                BOOST_CHECK_EQUAL(prices[6], decimal4("0.0001"));
+                BOOST_CHECK_EQUAL(quantities[6], decimal2("1.01"));
+
+                BOOST_REQUIRE_EQUAL(errors.size(), 4u);
+                BOOST_CHECK_EQUAL(errors[0].row, 2u);
+                BOOST_CHECK_EQUAL(errors[0].field, 1u);
+                BOOST_CHECK_EQUAL(text.substr(errors[0].offset, 2), "x1");
+                BOOST_CHECK(errors[0].ec == std::errc::invalid_argument);
+                BOOST_CHECK_EQUAL(errors[1].row, 3u);
+                BOOST_CHECK(errors[1].ec == std::errc::result_out_of_range);
+                // missing field, offset of row end
+                BOOST_CHECK_EQUAL(errors[2].row, 4u);
+                BOOST_CHECK_EQUAL(errors[2].field, 2u);
+                BOOST_CHECK(errors[2].ec == std::errc::invalid_argument);
+                BOOST_CHECK_EQUAL(errors[2].offset, text.find("MNO;7.25") + 8);
+                BOOST_CHECK_EQUAL(text[errors[2].offset], '\r');
+                // empty field
+                BOOST_CHECK_EQUAL(errors[3].row, 5u);
+                BOOST_CHECK_EQUAL(errors[3].field, 2u);
+
+                // empty input, header only
+                errors.clear();
+                BOOST_CHECK_EQUAL(reader.parse(text.data(), text.data(), errors), 0u);
+                BOOST_CHECK_EQUAL(reader.parse(text.data(), text.data() + 28, errors), 0u);
+                BOOST_CHECK(prices.empty());
+                BOOST_CHECK(errors.empty());
+        }
+
+BOOST_AUTO_TEST_CASE(decimalCsvReaderThreads)
+        {
+                using namespace dec;
+
+                // several chunks, rows of different length cross chunk boundaries
+                std::string text;
+                const std::size_t rowCount = 50000;
+                for (std::size_t row = 0; row < rowCount; ++row) {
+                    const long long value = static_cast<long long>(row * 7919 % 1000003) - 500000;
+                    text += std::to_string(row) + ",";
+                    text += (row % 997 == 0) ? std::string("bad") : std::to_string(value) + "."
+                            + std::to_string(row % 100);
+                    text += (row % 13 == 0) ? "\n" : ",123456.7890123,extra\n";
+                }
+
+                std::vector<decimal<3> > values1;
+                std::vector<decimal<3> > values4;
+                std::vector<decimal6> extra4;
+                std::vector<csv_error> errors1;
+                std::vector<csv_error> errors4;
+                csv_reader(',').column(1, values1).parse(text.data(), text.data() + text.size(),
+                        errors1, 1);
+                const std::size_t rows = csv_reader(',').column(2, extra4).column(1, values4).parse(
+                        text.data(), text.data() + text.size(), errors4, 4);
+
+                BOOST_CHECK_EQUAL(rows, rowCount);
+                BOOST_CHECK(values1 == values4);
+                BOOST_CHECK_EQUAL(values4[1], decimal<3>("-492081.1"));
+                BOOST_CHECK_EQUAL(extra4[1], decimal6("123456.789012"));
+                BOOST_CHECK_EQUAL(extra4[13], decimal6(0));
+
+                // errors of column 1 are the same, extra errors for missing column 2
+                std::size_t badRows = 0;
+                std::size_t missing = 0;
+                for (std::size_t i = 0; i < errors4.size(); ++i) {
+                    if (errors4[i].field == 1) {
+                        BOOST_CHECK_EQUAL(errors4[i].row, errors1[badRows].row);
+                        BOOST_CHECK_EQUAL(errors4[i].offset, errors1[badRows].offset);
+                        ++badRows;
+                    } else {
+                        BOOST_CHECK_EQUAL(errors4[i].row % 13, 0u);
+                        ++missing;
+                    }
+                    if (i > 0) {
+                        BOOST_CHECK(errors4[i - 1].row <= errors4[i].row);
+                    }
+                }
+                BOOST_CHECK_EQUAL(badRows, errors1.size());
+                BOOST_CHECK_EQUAL(badRows, (rowCount + 996) / 997);
+                BOOST_CHECK_EQUAL(missing, (rowCount + 12) / 13);
+        }
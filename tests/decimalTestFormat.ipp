@@ -0,0 +1,191 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalTestFormat.ipp
+// Purpose:     Test decimal type - formatting and parsing with decimal_format.
+// Created:     15/10/2026
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_format.h"
+
+namespace {
+
+struct grouping_numpunct: public std::numpunct<char> {
+protected:
+    char do_decimal_point() const {
+        return ',';
+    }
+
+    char do_thousands_sep() const {
+        return ' ';
+    }
+
+    std::string do_grouping() const {
+        return "\3";
+    }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFormatOutput)
+        {
+                using namespace dec;
+
+                // default format is the same as to_chars
+                const decimal_format plain;
+                BOOST_CHECK_EQUAL(plain.format(decimal2("-1234567.5")), "-1234567.50");
+                BOOST_CHECK_EQUAL(plain.format(decimal<0>(42)), "42");
+                BOOST_CHECK_EQUAL(plain.format(decimal6("-0.000001")), "-0.000001");
+
+                // separators and grouping from locale
+                const decimal_format local(std::locale(std::locale::classic(), new grouping_numpunct));
+                BOOST_CHECK_EQUAL(local.getDecimalPoint(), ',');
+                BOOST_CHECK(local.hasGrouping());
+                BOOST_CHECK_EQUAL(local.format(decimal2("-1234567.5")), "-1 234 567,50");
+                BOOST_CHECK_EQUAL(local.format(decimal2("123.5")), "123,50");
+                BOOST_CHECK_EQUAL(local.format(decimal<0>(1000)), "1 000");
+
+                // explicit grouping, the last group size is repeated (Indian style)
+                decimal_format indian;
+                indian.setGrouping(',', "\3\2");
+                BOOST_CHECK_EQUAL(indian.format(decimal2("123456789.25")), "12,34,56,789.25");
+
+                // sign styles
+                decimal_format accounting;
+                accounting.setSignStyle(decimal_format::sign_parentheses);
+                BOOST_CHECK_EQUAL(accounting.format(decimal2("-12.5")), "(12.50)");
+                BOOST_CHECK_EQUAL(accounting.format(decimal2("12.5")), "12.50");
+                decimal_format signed_format;
+                signed_format.setSignStyle(decimal_format::sign_always);
+                BOOST_CHECK_EQUAL(signed_format.format(decimal2("12.5")), "+12.50");
+                BOOST_CHECK_EQUAL(signed_format.format(decimal2("-12.5")), "-12.50");
+                BOOST_CHECK_EQUAL(signed_format.format(decimal2(0)), "+0.00");
+
+                // fraction digits: rounding with value's policy, trimming and padding
+                decimal_format fraction;
+                fraction.setFractionDigits(2, 2);
+                BOOST_CHECK_EQUAL(fraction.format(decimal4("1.2350")), "1.24");
+                BOOST_CHECK_EQUAL(fraction.format(decimal4("-1.2350")), "-1.24");
+                BOOST_CHECK_EQUAL(fraction.format(decimal4("-0.0049")), "0.00");
+                BOOST_CHECK_EQUAL(fraction.format(decimal<4, half_even_round_policy>("1.2350")), "1.24");
+                BOOST_CHECK_EQUAL(fraction.format(decimal<4, half_even_round_policy>("1.2250")), "1.22");
+                BOOST_CHECK_EQUAL(fraction.format(decimal<0>(7)), "7.00");
+                BOOST_CHECK_EQUAL(fraction.format(decimal4("9.999")), "10.00");
+                fraction.setFractionDigits(0, 4);
+                BOOST_CHECK_EQUAL(fraction.format(decimal6("1.500000")), "1.5");
+                BOOST_CHECK_EQUAL(fraction.format(decimal6("2.000049")), "2");
+                BOOST_CHECK_EQUAL(fraction.format(decimal6("2.123456")), "2.1235");
+                fraction.setFractionDigits(3, decimal_format::value_precision);
+                BOOST_CHECK_EQUAL(fraction.format(decimal6("1.500000")), "1.500");
+                BOOST_CHECK_EQUAL(fraction.format(decimal6("1.500001")), "1.500001");
+
+                // padding
+                decimal_format padded;
+                padded.setWidth(10);
+                BOOST_CHECK_EQUAL(padded.format(decimal2("-1.5")), "     -1.50");
+                padded.setWidth(10, '*', decimal_format::align_left);
+                BOOST_CHECK_EQUAL(padded.format(decimal2("-1.5")), "-1.50*****");
+                padded.setWidth(10, '0', decimal_format::align_internal);
+                BOOST_CHECK_EQUAL(padded.format(decimal2("-1.5")), "-000001.50");
+                padded.setWidth(200);
+                BOOST_CHECK_EQUAL(padded.format(decimal2("1.5")).size(), 200u);
+
+                // character buffer, output string is reused
+                char buffer[16];
+                to_chars_result res = local.format(buffer, buffer + sizeof(buffer), decimal2("-1234.5"));
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK_EQUAL(std::string(buffer, res.ptr), "-1 234,50");
+                res = local.format(buffer, buffer + 4, decimal2("-1234.5"));
+                BOOST_CHECK(res.ec == std::errc::value_too_large);
+                BOOST_CHECK(res.ptr == buffer + 4);
+                std::string text;
+                local.format(decimal4("0.5"), text);
+                BOOST_CHECK_EQUAL(text, "0,5000");
+
+#ifdef DEC_HAS_INT128
+                typedef decimal<2, def_round_policy, unchecked_overflow_policy, int128> dec2_wide;
+                BOOST_CHECK_EQUAL(local.format(dec2_wide("-12345678901234567890.25")),
+                        "-12 345 678 901 234 567 890,25");
+#endif
+        }
+
+BOOST_AUTO_TEST_CASE(decimalFormatInput)
+        {
+                using namespace dec;
+
+                decimal_format local(std::locale(std::locale::classic(), new grouping_numpunct));
+                local.setSignStyle(decimal_format::sign_parentheses);
+                decimal2 value;
+                const char *text = "-1 234 567,505 rest";
+                from_chars_result res = local.parse(text, text + std::strlen(text), value);
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK_EQUAL(value, decimal2("-1234567.51"));
+                BOOST_CHECK_EQUAL(std::string(res.ptr), " rest");
+
+                // formatted values are parsed back
+                const decimal4 values[] = { decimal4(0), decimal4("-0.0001"), decimal4("123456.789"),
+                        decimal4("-922337203685477.5808") };
+                local.setWidth(30, '*');
+                for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+                    const std::string formatted = local.format(values[i]);
+                    decimal4 parsed(1);
+                    res = local.parse(formatted.data(), formatted.data() + formatted.size(), parsed);
+                    BOOST_CHECK(res.ec == std::errc());
+                    BOOST_CHECK(res.ptr == formatted.data() + formatted.size());
+                    BOOST_CHECK_EQUAL(parsed, values[i]);
+                }
+
+                // all alignments and sign styles
+                const decimal_format::alignment alignments[] = { decimal_format::align_right,
+                        decimal_format::align_left, decimal_format::align_internal };
+                const decimal_format::sign_style signs[] = { decimal_format::sign_negative,
+                        decimal_format::sign_always, decimal_format::sign_parentheses };
+                const char fills[] = { ' ', '*', '0' };
+                const decimal2 amounts[] = { decimal2("-12.5"), decimal2("12.5"), decimal2(0),
+                        decimal2("-1234567.89") };
+                for (size_t a = 0; a < sizeof(alignments) / sizeof(alignments[0]); ++a) {
+                    for (size_t s = 0; s < sizeof(signs) / sizeof(signs[0]); ++s) {
+                        for (size_t f = 0; f < sizeof(fills) / sizeof(fills[0]); ++f) {
+                            decimal_format aligned(local);
+                            aligned.setWidth(16, fills[f], alignments[a]).setSignStyle(signs[s]);
+                            for (size_t i = 0; i < sizeof(amounts) / sizeof(amounts[0]); ++i) {
+                                const std::string formatted = aligned.format(amounts[i]);
+                                decimal2 parsed(1);
+                                res = aligned.parse(formatted.data(), formatted.data() + formatted.size(),
+                                        parsed);
+                                BOOST_CHECK_MESSAGE(res.ec == std::errc(), "parse of \"" << formatted << "\"");
+                                BOOST_CHECK_EQUAL(parsed, amounts[i]);
+                                // only fill characters after value
+                                const char *end = formatted.data() + formatted.size();
+                                BOOST_CHECK_EQUAL(std::string(res.ptr, end),
+                                        std::string(static_cast<size_t>(end - res.ptr), fills[f]));
+                            }
+                        }
+                    }
+                }
+                text = "-    12.50";
+                BOOST_CHECK(decimal_format().parse(text, text + std::strlen(text), value).ec == std::errc());
+                BOOST_CHECK_EQUAL(value, decimal2("-12.5"));
+
+                // without grouping separator ends the value, extra fraction digits are rounded
+                const decimal_format plain;
+                text = "12,5";
+                res = plain.parse(text, text + 4, value);
+                BOOST_CHECK(res.ec == std::errc());
+                BOOST_CHECK_EQUAL(value, decimal2(12));
+                BOOST_CHECK(res.ptr == text + 2);
+                text = "0.00500000000000000000000000000000000000000001";
+                res = plain.parse(text, text + std::strlen(text), value);
+                BOOST_CHECK_EQUAL(value, decimal2("0.01"));
+                BOOST_CHECK(res.ptr == text + std::strlen(text));
+
+                // errors leave output unchanged
+                value = decimal2(3);
+                text = "(12.5";
+                BOOST_CHECK(local.parse(text, text + 5, value).ec == std::errc::invalid_argument);
+                text = "x";
+                BOOST_CHECK(plain.parse(text, text + 1, value).ec == std::errc::invalid_argument);
+                text = "1000000000000000000000";
+                BOOST_CHECK(plain.parse(text, text + std::strlen(text), value).ec
+                        == std::errc::result_out_of_range);
+                BOOST_CHECK_EQUAL(value, decimal2(3));
+        }
@@ -19,7 +19,20 @@ extern int putenv(char*);
 #define BOOST_TEST_MODULE "C++ Unit Tests for decimal"
 #include <boost/test/included/unit_test.hpp>
 
+// library headers use standard headers, which cannot be included inside test suite namespace
+#include "decimal.h"
+#include "decimal_batch.h"
+#include "decimal_codec.h"
+#include "decimal_column.h"
+#include "decimal_csv.h"
+#include "decimal_format.h"
+#include "decimal_parallel.h"
+
 BOOST_AUTO_TEST_SUITE ( test )
 #include "decimalTest.ipp"
+#include "decimalTestBatch.ipp"
+#include "decimalTestFormat.ipp"
+#include "decimalTestCsv.ipp"
+#include "decimalTestCodec.ipp"
 //#include "decimalTestIo.ipp"
 BOOST_AUTO_TEST_SUITE_END( )